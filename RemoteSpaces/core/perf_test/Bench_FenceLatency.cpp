@@ -0,0 +1,109 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  H. Carter Edwards (hcedwar@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+#include <mpi.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+typedef Kokkos::View<double**, Kokkos::MPISpace> remote_view_type;
+
+/* Average cost of MPISpace::fence() with num_views live remote views of which
+ * only the first one has outstanding operations */
+double time_fence(const int num_views, const int repeat) {
+  int myRank, numRanks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+  MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+  const int target = (myRank + 1) % numRanks;
+
+  std::vector<remote_view_type> views;
+  for (int i = 0; i < num_views; i++)
+    views.push_back(Kokkos::allocate_symmetric_remote_view<remote_view_type>(
+        "FenceLatency", numRanks, NULL, 1));
+
+  Kokkos::MPISpace space;
+  space.fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+  double start = MPI_Wtime();
+  for (int r = 0; r < repeat; r++) {
+    views[0](target, 0) = double(r);
+    space.fence();
+  }
+  double time = (MPI_Wtime() - start) / repeat;
+  MPI_Allreduce(MPI_IN_PLACE, &time, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+
+  MPI_Barrier(MPI_COMM_WORLD);
+  return time;
+}
+
+int main(int argc, char* argv[]) {
+  MPI_Init(&argc, &argv);
+  Kokkos::initialize(argc, argv);
+  {
+    const int max_views = argc > 1 ? atoi(argv[1]) : 256;
+    const int repeat    = argc > 2 ? atoi(argv[2]) : 100;
+
+    int myRank, numRanks;
+    MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+
+    const char* mode_names[] = {"active ", "passive"};
+    for (int mode = Kokkos::MPISpace::ActiveTarget;
+         mode <= Kokkos::MPISpace::PassiveTarget; mode++) {
+      Kokkos::MPISpace::set_rma_mode(mode);
+      for (int num_views = 1; num_views <= max_views; num_views *= 2) {
+        const double time = time_fence(num_views, repeat);
+        if (myRank == 0)
+          printf("Mode %s: ranks %i views %i fence latency %e s\n",
+                 mode_names[mode], numRanks, num_views, time);
+      }
+    }
+    Kokkos::MPISpace::set_rma_mode(Kokkos::MPISpace::ActiveTarget);
+  }
+  Kokkos::finalize();
+  MPI_Finalize();
+  return 0;
+}
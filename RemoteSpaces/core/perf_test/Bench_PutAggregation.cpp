@@ -0,0 +1,113 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  H. Carter Edwards (hcedwar@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+#include <mpi.h>
+
+#include <cstdio>
+#include <cstdlib>
+
+typedef Kokkos::View<double**, Kokkos::MPISpace> remote_view_type;
+
+/* Every rank scatters N doubles into the partition of its right neighbor */
+double time_scatter(remote_view_type v, const int N, const int repeat) {
+  int myRank, numRanks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+  MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+  const int target = (myRank + 1) % numRanks;
+
+  Kokkos::MPISpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+  double start = MPI_Wtime();
+  for (int r = 0; r < repeat; r++) {
+    Kokkos::parallel_for(
+        "PutAggregation", N, KOKKOS_LAMBDA(const int i) {
+          v(target, i) = double(r + i);
+        });
+    Kokkos::fence();
+    Kokkos::MPISpace().fence();
+  }
+  double time = MPI_Wtime() - start;
+  MPI_Allreduce(MPI_IN_PLACE, &time, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+  return time;
+}
+
+int main(int argc, char* argv[]) {
+  int provided;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+  if (provided < MPI_THREAD_MULTIPLE) {
+    fprintf(stderr, "MPI_THREAD_MULTIPLE is not supported\n");
+    MPI_Abort(MPI_COMM_WORLD, 1);
+  }
+  Kokkos::initialize(argc, argv);
+  {
+    const int N         = argc > 1 ? atoi(argv[1]) : 1 << 20;
+    const int repeat    = argc > 2 ? atoi(argv[2]) : 10;
+    const int threshold = argc > 3 ? atoi(argv[3]) : 65536;
+
+    int myRank, numRanks;
+    MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+
+    remote_view_type v =
+        Kokkos::allocate_symmetric_remote_view<remote_view_type>(
+            "PutAggregation", numRanks, NULL, N);
+
+    const double puts  = double(N) * repeat;
+    const double bytes = puts * sizeof(double);
+    for (int aggregate = 0; aggregate < 2; aggregate++) {
+      Kokkos::MPISpace::set_put_aggregation(aggregate, threshold);
+      const double time = time_scatter(v, N, repeat);
+      if (myRank == 0)
+        printf("Aggregation %s: ranks %i N %i threshold %i time %e s "
+               "puts/s %e bytes/s %e\n",
+               aggregate ? "on " : "off", numRanks, N, threshold, time,
+               puts / time, bytes / time);
+    }
+    Kokkos::MPISpace::set_put_aggregation(false);
+  }
+  Kokkos::finalize();
+  MPI_Finalize();
+  return 0;
+}
@@ -51,6 +51,7 @@
 
 #include <Kokkos_Core_fwd.hpp>
 #include <Kokkos_Concepts.hpp>
+#include <Kokkos_HostSpace.hpp>
 #include <Kokkos_MemoryTraits.hpp>
 
 #include <impl/Kokkos_Traits.hpp>
@@ -59,11 +60,107 @@
 
 #include <Kokkos_RemoteSpaces.hpp>
 #include <mpi.h>
+#include <atomic>
+#include <list>
+#include <map>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 /*--------------------------------------------------------------------------*/
 
 namespace Kokkos {
 
+namespace Impl {
+
+struct MPIWindows {
+  MPI_Win win;
+  MPI_Win shm_win;
+  MPI_Comm comm;
+  // Start of the local window memory
+  char* base;
+  // Mapping backing the window if it is owned by MPISpace, NULL if the
+  // memory was allocated by MPI
+  void* mem;
+  size_t mem_size;
+  // Set while RMA operations on win are pending.  NULL if win is fenced
+  // unconditionally because direct accesses to it are not tracked.
+  std::atomic<bool>* dirty;
+};
+
+/**\brief Windows of all live MPISpace allocations.
+ *
+ *  Entries are keyed by the allocation pointer, which is the header of the
+ *  owning SharedAllocationRecord.  Insertion, lookup and removal are O(1)
+ *  and safe to call from concurrent host threads.  Iteration visits the
+ *  windows in allocation order so that collective window operations are
+ *  issued in the same order on every rank.
+ */
+class MPIWindowRegistry {
+ public:
+  void insert(const void* arg_alloc_ptr, const MPIWindows& arg_windows);
+
+  bool find(const void* arg_alloc_ptr, MPIWindows& arg_windows) const;
+
+  bool erase(const void* arg_alloc_ptr, MPIWindows& arg_windows);
+
+  std::vector<MPIWindows> windows() const;
+
+  size_t size() const;
+
+ private:
+  typedef std::list<std::pair<const void*, MPIWindows>> list_type;
+
+  mutable std::mutex m_mutex;
+  list_type m_list;
+  std::unordered_map<const void*, list_type::iterator> m_map;
+};
+
+/**\brief Symmetric heap carved out of a single MPI window.
+ *
+ *  Blocks are handed out first-fit from a free list ordered by offset and
+ *  coalesced on release.  The resulting offsets only depend on the set of
+ *  live blocks, so every rank obtains the same offset for an allocation as
+ *  long as all ranks allocate in the same order and free the same blocks
+ *  before their next allocation.
+ */
+class MPISymmetricHeap {
+ public:
+  MPISymmetricHeap();
+
+  /* Collective over arg_comm */
+  void create(const size_t arg_size, const MPI_Comm& arg_comm);
+
+  /* Collective over the communicator of the heap */
+  void destroy();
+
+  /* Returns NULL if the heap is not active or exhausted */
+  void* allocate(const size_t arg_alloc_size);
+
+  bool deallocate(const void* arg_alloc_ptr);
+
+  bool contains(const void* arg_alloc_ptr) const;
+
+  /* Offset of an allocation from the start of the heap window */
+  MPI_Aint displacement(const void* arg_alloc_ptr) const;
+
+  bool active() const { return m_base != NULL; }
+
+  size_t size() const { return m_size; }
+
+  size_t live_allocations() const;
+
+  MPIWindows windows;
+
+ private:
+  mutable std::mutex m_mutex;
+  char* m_base;
+  size_t m_size;
+  std::map<size_t, size_t> m_free;
+  std::unordered_map<size_t, size_t> m_used;
+};
+
+}  // namespace Impl
+
 class MPISpace {
  public:
   typedef MPISpace memory_space;
@@ -95,6 +192,12 @@ class MPISpace {
   MPISpace& operator=(const MPISpace&) = default;
   ~MPISpace()                          = default;
 
+  /**\brief Space whose allocations span only the ranks of comm.
+   *
+   *  Window creation and fence() are collective over comm, and the leading
+   *  dimension of remote views indexes ranks of comm.  The communicator must
+   *  remain valid while allocations of the space are live.
+   */
   explicit MPISpace(const MPI_Comm&);
 
   void* allocate(const size_t arg_alloc_size) const;
@@ -109,15 +212,104 @@ class MPISpace {
   /**\brief Return Name of the MemorySpace */
   static constexpr const char* name() { return m_name; }
 
+  /**\brief Complete the RMA operations of all windows of comm.
+   *
+   *  Only windows with operations pending since their last fence are
+   *  flushed.  In active-target mode the ranks then synchronize with a
+   *  single barrier.
+   */
   void fence();
 
+  /**\brief Complete the non-blocking gets issued by this process.
+   *
+   *  In passive-target mode gets are issued with MPI_Rget and wait_all()
+   *  completes them locally, without synchronizing with other ranks.  In
+   *  active-target mode they complete at the next fence().
+   */
+  void wait_all();
+
+  MPI_Comm comm;
   int* rank_list;
   int allocation_mode;
   int64_t extent;
 
-  static std::vector<MPI_Win> mpi_windows;
-
-  static MPI_Win current_win;
+  static Impl::MPIWindowRegistry window_registry;
+
+  /**\brief Write-combine element puts per target rank and window.
+   *
+   *  Buffered puts are issued as one MPI_Put per target at fence() or once
+   *  the buffer of a target reaches threshold bytes.
+   */
+  static void set_put_aggregation(const bool enable,
+                                  const size_t threshold = 65536);
+
+  static bool put_aggregation;
+  static size_t put_aggregation_threshold;
+
+  enum { ActiveTarget, PassiveTarget };
+
+  /**\brief Select how RMA epochs of new windows are synchronized.
+   *
+   *  Every window is opened with MPI_Win_lock_all at allocation, so element
+   *  gets and atomics complete on return in both modes.  In ActiveTarget
+   *  (default) mode fence() flushes the operations of each rank and then
+   *  synchronizes all ranks of the communicator, which makes every update
+   *  visible to every rank.  In PassiveTarget mode fence() only flushes the
+   *  operations issued by the calling rank, without synchronizing with
+   *  other ranks.  The mode can only be changed while no MPISpace windows
+   *  are allocated.
+   */
+  static void set_rma_mode(const int mode);
+
+  static int rma_mode;
+
+  /**\brief Back new windows with MPI shared-memory windows.
+   *
+   *  Memory is allocated with MPI_Win_allocate_shared on the node-local
+   *  communicator and exposed to all ranks through an MPI_Win_create window.
+   *  Elements owned by ranks on the same node are then accessed with
+   *  direct loads and stores instead of RMA operations.
+   */
+  static void set_shared_memory_windows(const bool enable);
+
+  static bool shared_memory_windows;
+
+  /**\brief Suballocate MPI_COMM_WORLD allocations from one window.
+   *
+   *  Collectively creates a window of size bytes per rank on MPI_COMM_WORLD
+   *  from which allocations are carved at symmetric offsets, avoiding a
+   *  collective window creation per allocation.  Allocations that do not fit
+   *  and allocations on other communicators get their own window.  A size
+   *  of zero releases the heap, which requires all of its allocations to be
+   *  freed.  The heap picks up the RMA mode and shared-memory setting in
+   *  effect when it is created.
+   */
+  static void set_symmetric_heap(const size_t size);
+
+  static Impl::MPISymmetricHeap symmetric_heap;
+
+  /**\brief Back new windows with 2 MB huge pages.
+   *
+   *  Window memory is mapped by MPISpace from explicit huge pages if the
+   *  system reserves them, and from a 2 MB aligned mapping advised for
+   *  transparent huge pages otherwise, then exposed with MPI_Win_create.
+   *  The payload of every allocation starts on a page boundary.  Ignored
+   *  for shared-memory windows, whose memory MPI allocates.
+   */
+  static void set_huge_pages(const bool enable);
+
+  static bool huge_pages;
+
+  /**\brief Drop the ordering of accumulate operations in new windows.
+   *
+   *  Passes accumulate_ordering=none to window creation, which lets MPI
+   *  complete atomic operations from one rank to the same element out of
+   *  order.  Off by default since an update may then overtake a preceding
+   *  one.
+   */
+  static void set_relaxed_accumulate_ordering(const bool enable);
+
+  static bool relaxed_accumulate_ordering;
 
   void impl_set_rank_list(int* const);
   void impl_set_allocation_mode(const int);
@@ -128,6 +320,40 @@ class MPISpace {
   friend class Kokkos::Impl::SharedAllocationRecord<Kokkos::MPISpace, void>;
 };
 
+namespace Impl {
+
+void mpi_aggregate_put(const void* val, const size_t size, const MPI_Aint disp,
+                       const int pe, const MPI_Win win);
+
+void mpi_flush_aggregated_puts();
+
+void mpi_flush_aggregated_puts(const MPI_Win win);
+
+/* Issues the puts to (win, pe) buffered by the calling thread */
+void mpi_flush_thread_puts(const MPI_Win win, const int pe);
+
+/* Releases the staging memory of the puts issued to wins, which the caller
+ * has flushed */
+void mpi_release_aggregated_puts(const std::vector<MPI_Win>& wins);
+
+void mpi_track_request(const MPI_Request request);
+
+void mpi_wait_requests();
+
+/* Completes the operations on one window, collective over comm in
+ * active-target mode */
+void mpi_fence_window(const MPI_Win win, const MPI_Comm& comm,
+                      std::atomic<bool>* dirty);
+
+/* Collective over comm, same_size promises that every rank passes the same
+ * size */
+MPIWindows mpi_create_windows(const size_t size, const MPI_Comm& comm,
+                              void** ptr, const bool same_size);
+
+void mpi_free_windows(MPIWindows& windows);
+
+}  // namespace Impl
+
 }  // namespace Kokkos
 
 //----------------------------------------------------------------------------
@@ -180,6 +406,21 @@ class SharedAllocationRecord<Kokkos::MPISpace, void>
 
   MPI_Win win;
 
+  /* Displacement of the allocation header in win */
+  MPI_Aint base_offset;
+
+  /* Node-local shared-memory window and the base addresses of the
+   * partitions of all ranks, NULL for ranks on other nodes */
+  MPI_Win shm_win;
+  std::vector<void*> peer_ptrs;
+
+  /* Pending operation flag of win, see MPIWindows */
+  std::atomic<bool>* dirty;
+
+  /* Offsets of the partitions of all ranks along the leading partition
+   * extent, followed by the total.  Empty for symmetric allocations. */
+  std::vector<int64_t> partition_offsets;
+
   inline std::string get_label() const {
     return std::string(RecordBase::head()->m_label);
   }
@@ -237,15 +478,7 @@ struct VerifyExecutionCanAccessMemorySpace<Kokkos::HostSpace,
   inline static void verify(const void*) {}
 };
 
-template <class ExecutionSpace>
-struct DeepCopy<MPISpace, MPISpace, ExecutionSpace> {
-  DeepCopy(void* dst, const void* src, size_t n) { memcpy(dst, src, n); }
-
-  DeepCopy(const ExecutionSpace& exec, void* dst, const void* src, size_t n) {
-    exec.fence();
-    memcpy(dst, src, n);
-  }
-};
+KOKKOS_IMPL_REMOTE_SPACE_HOST_DEEP_COPY(MPISpace)
 
 }  // namespace Impl
 
@@ -2,17 +2,21 @@
 #define __KOKKOS_POST_INCLUDE_REMOTESPACES
 
 #include <Kokkos_SetDefault_RemoteSpace.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 namespace Kokkos {
 
 template <typename ViewType, class... Args>
-ViewType allocate_symmetric_remote_view(const char* const label, int num_ranks,
-                                        int* rank_list, Args... args) {
-  typedef typename ViewType::memory_space t_mem_space;
+ViewType allocate_symmetric_remote_view(
+    const char* const label, typename ViewType::memory_space space,
+    int num_ranks, int* rank_list, Args... args) {
   typedef typename ViewType::array_layout t_layout;
 
-  t_mem_space space;
   int64_t size = ViewType::required_allocation_size(1, args...);
   space.impl_set_allocation_mode(Kokkos::Symmetric);
   space.impl_set_rank_list(rank_list);
@@ -22,8 +26,412 @@ ViewType allocate_symmetric_remote_view(const char* const label, int num_ranks,
                   args...);
 }
 
+template <typename ViewType, class... Args>
+ViewType allocate_symmetric_remote_view(const char* const label, int num_ranks,
+                                        int* rank_list, Args... args) {
+  return allocate_symmetric_remote_view<ViewType>(
+      label, typename ViewType::memory_space(), num_ranks, rank_list, args...);
+}
+
+/**\brief Allocate a remote view whose partitions differ in their leading
+ *  extent.  Every rank passes the extent of its own partition, the extents
+ *  of all ranks are exchanged once at allocation.  Elements are indexed as
+ *  in symmetric views, with the leading partition index of rank pe below
+ *  Experimental::get_partition_extent(view, pe).  extent(1) of the view is
+ *  that of the largest partition, a subview restricted to rank pe has the
+ *  extent of its partition.
+ *
+ *  MPISpace sizes the window of every rank to its own partition.
+ *  OpenSHMEM symmetric objects have the same size on every PE, so
+ *  SHMEMSpace allocates the largest partition on all PEs and only the
+ *  indexing is asymmetric.
+ */
+template <typename ViewType, class... Args>
+ViewType allocate_asymmetric_remote_view(const char* const label,
+                                         typename ViewType::memory_space space,
+                                         int num_ranks, int* rank_list,
+                                         int64_t local_extent, Args... args) {
+  static_assert(ViewType::rank >= 2,
+                "Asymmetric remote views require a partition dimension");
+  // The strides of a partition may not depend on its leading extent
+  static_assert(std::is_same<typename ViewType::array_layout,
+                             Kokkos::LayoutRight>::value,
+                "Asymmetric remote views require LayoutRight");
+  space.impl_set_allocation_mode(Kokkos::Asymmetric);
+  space.impl_set_rank_list(rank_list);
+  space.impl_set_extent(local_extent);
+  return ViewType(Kokkos::view_alloc(std::string(label), space), num_ranks,
+                  local_extent, args...);
+}
+
+template <typename ViewType, class... Args>
+ViewType allocate_asymmetric_remote_view(const char* const label,
+                                         int num_ranks, int* rank_list,
+                                         int64_t local_extent, Args... args) {
+  return allocate_asymmetric_remote_view<ViewType>(
+      label, typename ViewType::memory_space(), num_ranks, rank_list,
+      local_extent, args...);
+}
+
+namespace Impl {
+
+/* Offset table of an asymmetric allocation, NULL for symmetric views */
+template <class RemoteView>
+const int64_t* remote_partition_offsets(const RemoteView& view) {
+  return view.impl_map().partition_offsets();
+}
+
+/* Number of elements in the partition of rank pe */
+template <class RemoteView>
+size_t remote_partition_span(const RemoteView& view, const int pe) {
+  const int64_t* const offsets = remote_partition_offsets(view);
+  if (!offsets) return view.span();
+  return size_t(offsets[pe + 1] - offsets[pe]) * view.stride_1();
+}
+
+/* Rank of the calling process in the communicator of a remote view */
+template <class RemoteView>
+int remote_my_pe(const RemoteView& view) {
+  typedef typename RemoteView::traits::specialize::backend_type backend_type;
+  return backend_type::my_pe(view.impl_map().handle());
+}
+
+/* Data type of rank N with dynamic extents */
+template <class T, int N>
+struct RemoteLocalDataType {
+  typedef typename RemoteLocalDataType<T*, N - 1>::type type;
+};
+
+template <class T>
+struct RemoteLocalDataType<T, 0> {
+  typedef T type;
+};
+
+/* Unmanaged view of the partition owned by the calling rank */
+template <class RemoteView>
+struct RemoteLocalView {
+  typedef typename RemoteView::traits traits;
+  typedef typename traits::specialize::backend_type backend_type;
+  typedef Kokkos::View<
+      typename RemoteLocalDataType<typename traits::value_type,
+                                   traits::rank - 1>::type,
+      typename traits::array_layout,
+      typename backend_type::local_memory_space,
+      Kokkos::MemoryTraits<Kokkos::Unmanaged>>
+      type;
+};
+
+/* Drops the leading rank index of a remote view layout */
+template <class Layout>
+Layout remote_local_layout(const Layout& src) {
+  Layout dst(src);
+  for (int r = 0; r < 7; r++) dst.dimension[r] = src.dimension[r + 1];
+  return dst;
+}
+
+inline Kokkos::LayoutStride remote_local_layout(
+    const Kokkos::LayoutStride& src) {
+  Kokkos::LayoutStride dst(src);
+  for (int r = 0; r < 7; r++) {
+    dst.dimension[r] = src.dimension[r + 1];
+    dst.stride[r]    = src.stride[r + 1];
+  }
+  return dst;
+}
+
+/* Transfer of count elements between a local buffer and the partition of
+ * rank pe, starting at element offset.  Specialized by each remote space. */
+template <class Specialize>
+struct RemoteBlockTransfer;
+
+template <class LocalView, class RemoteView>
+void check_remote_block_transfer(const LocalView& local,
+                                 const RemoteView& remote, const int pe,
+                                 const Kokkos::pair<size_t, size_t>& range) {
+  static_assert(std::is_same<typename LocalView::non_const_value_type,
+                             typename RemoteView::non_const_value_type>::value,
+                "Local and remote views must have the same value type");
+  static_assert(
+      Kokkos::Impl::MemorySpaceAccess<
+          Kokkos::HostSpace, typename LocalView::memory_space>::accessible,
+      "Local view of a remote transfer must be host accessible");
+  if (range.first > range.second ||
+      range.second > remote_partition_span(remote, pe))
+    Kokkos::abort("Remote transfer range exceeds the remote partition.");
+  if (!local.span_is_contiguous() ||
+      local.span() < range.second - range.first)
+    Kokkos::abort("Remote transfer requires a contiguous local view that "
+                  "holds the whole range.");
+}
+
+template <class SignalView>
+void check_remote_signal(const SignalView& signal, const int pe,
+                         const size_t idx) {
+  static_assert(std::is_same<typename SignalView::non_const_value_type,
+                             uint64_t>::value,
+                "Signal views must hold uint64_t");
+  if (idx >= remote_partition_span(signal, pe))
+    Kokkos::abort("Signal index exceeds the signal partition.");
+}
+
+}  // namespace Impl
+
+namespace Experimental {
+
+/**\brief Leading extent of the partition owned by rank pe */
+template <class RemoteView>
+size_t get_partition_extent(const RemoteView& view, const int pe) {
+  return view.impl_map().partition_extent(pe);
+}
+
+/**\brief Global leading index of the first element of the partition owned
+ *  by rank pe, with partitions numbered in rank order */
+template <class RemoteView>
+size_t get_partition_offset(const RemoteView& view, const int pe) {
+  return view.impl_map().partition_offset(pe);
+}
+
+/**\brief Rank owning the global leading index i */
+template <class RemoteView>
+int get_partition_owner(const RemoteView& view, const size_t i) {
+  const int64_t* const offsets = Impl::remote_partition_offsets(view);
+  if (!offsets) return int(i / view.extent(1));
+  const int num_pes = view.impl_map().num_pes();
+  return int(std::upper_bound(offsets + 1, offsets + num_pes + 1, int64_t(i)) -
+             (offsets + 1));
+}
+
+/**\brief Range policy over the global leading indices [begin, end) of a
+ *  remote view that are owned by the calling rank.
+ *
+ *  The functor receives the index into the partition of the calling rank,
+ *  i.e. view(my_pe, i, ...) with i the global index minus
+ *  get_partition_offset(view, my_pe).  Indices owned by other ranks are
+ *  skipped, so owner-computes loops never touch remote elements.
+ *  Properties are forwarded to Kokkos::RangePolicy.
+ */
+template <class... Properties, class RemoteView>
+Kokkos::RangePolicy<Properties...> RemoteRangePolicy(const RemoteView& view,
+                                                     const size_t begin,
+                                                     const size_t end) {
+  const int pe        = Impl::remote_my_pe(view);
+  const size_t offset = get_partition_offset(view, pe);
+  const size_t extent = get_partition_extent(view, pe);
+  const size_t first  = std::min(std::max(begin, offset), offset + extent);
+  const size_t last   = std::max(std::min(end, offset + extent), first);
+  return Kokkos::RangePolicy<Properties...>(first - offset, last - offset);
+}
+
+/**\brief Range policy over the whole partition owned by the calling rank,
+ *  handing the functor the index into that partition */
+template <class... Properties, class RemoteView>
+Kokkos::RangePolicy<Properties...> LocalPartitionPolicy(
+    const RemoteView& view) {
+  return Kokkos::RangePolicy<Properties...>(
+      0, get_partition_extent(view, Impl::remote_my_pe(view)));
+}
+
+/**\brief Unmanaged view of the partition owned by the calling rank.
+ *
+ *  The result aliases the memory of the remote view without a copy and is
+ *  indexed as view(my_pe, ...) without the leading rank index, with the
+ *  same layout and strides.  Its memory space is the local memory space of
+ *  the backend, so purely local kernels access it directly.  The remote
+ *  view must outlive it, and remote updates become visible at fence().
+ */
+template <class RemoteView>
+typename Impl::RemoteLocalView<RemoteView>::type local_view(
+    const RemoteView& view) {
+  static_assert(RemoteView::rank >= 1,
+                "local_view requires a view indexed by rank");
+  if (view.impl_map().pe() >= 0)
+    Kokkos::abort("local_view requires a view indexed by rank.");
+  // Dimension 1 of an asymmetric view spans the largest partition
+  typename RemoteView::array_layout layout = view.layout();
+  if (Impl::remote_partition_offsets(view))
+    layout.dimension[1] = get_partition_extent(view, Impl::remote_my_pe(view));
+  return typename Impl::RemoteLocalView<RemoteView>::type(
+      view.data(), Impl::remote_local_layout(layout));
+}
+
+/**\brief Host mirror of the partition owned by the calling rank.
+ *
+ *  Returns local_view(view) when the local memory space of the backend is
+ *  host accessible and a newly allocated host view of the same shape
+ *  otherwise, following Kokkos::create_mirror_view.
+ */
+template <class RemoteView>
+typename Impl::RemoteLocalView<RemoteView>::type::HostMirror
+create_local_mirror_view(const RemoteView& view) {
+  return Kokkos::create_mirror_view(local_view(view));
+}
+
+/**\brief Copy elements [range.first, range.second) of the partition owned
+ *  by rank pe into the contiguous local view dst with a single transfer.
+ *  Ranges are in the offset space of one partition of the remote view.
+ */
+template <class LocalView, class RemoteView>
+void remote_get(const LocalView& dst, const RemoteView& src, const int pe,
+                const Kokkos::pair<size_t, size_t>& range) {
+  static_assert(!std::is_const<typename LocalView::value_type>::value,
+                "Destination of remote_get must not be const");
+  Impl::check_remote_block_transfer(dst, src, pe, range);
+  Impl::RemoteBlockTransfer<typename RemoteView::traits::specialize>::get(
+      dst.data(), src, pe, range.first, range.second - range.first);
+}
+
+template <class LocalView, class RemoteView>
+void remote_get(const LocalView& dst, const RemoteView& src, const int pe) {
+  remote_get(
+      dst, src, pe,
+      Kokkos::pair<size_t, size_t>(0, Impl::remote_partition_span(src, pe)));
+}
+
+/**\brief Copy the contiguous local view src into elements
+ *  [range.first, range.second) of the partition owned by rank pe of dst
+ *  with a single transfer.
+ */
+template <class RemoteView, class LocalView>
+void remote_put(const RemoteView& dst, const LocalView& src, const int pe,
+                const Kokkos::pair<size_t, size_t>& range) {
+  Impl::check_remote_block_transfer(src, dst, pe, range);
+  Impl::RemoteBlockTransfer<typename RemoteView::traits::specialize>::put(
+      src.data(), dst, pe, range.first, range.second - range.first);
+}
+
+template <class RemoteView, class LocalView>
+void remote_put(const RemoteView& dst, const LocalView& src, const int pe) {
+  remote_put(
+      dst, src, pe,
+      Kokkos::pair<size_t, size_t>(0, Impl::remote_partition_span(dst, pe)));
+}
+
+/**\brief Comparisons of remote_wait_until */
+enum {
+  RemoteCmpEq,
+  RemoteCmpNe,
+  RemoteCmpGt,
+  RemoteCmpGe,
+  RemoteCmpLt,
+  RemoteCmpLe
+};
+
+/**\brief remote_put followed by setting element idx of the partition owned
+ *  by rank pe of signal to value once the data has arrived there.
+ *
+ *  signal is a remote view of uint64_t spanning the same ranks as dst.  The
+ *  target rank waits for the data with remote_wait_until instead of a
+ *  fence.  MPISpace requires the PassiveTarget RMA mode.
+ */
+template <class RemoteView, class LocalView, class SignalView>
+void remote_put_signal(const RemoteView& dst, const LocalView& src,
+                       const int pe, const Kokkos::pair<size_t, size_t>& range,
+                       const SignalView& signal, const size_t idx,
+                       const uint64_t value = 1) {
+  Impl::check_remote_block_transfer(src, dst, pe, range);
+  Impl::check_remote_signal(signal, pe, idx);
+  Impl::RemoteBlockTransfer<typename RemoteView::traits::specialize>::
+      put_signal(src.data(), dst, pe, range.first, range.second - range.first,
+                 signal, idx, value);
+}
+
+/**\brief Wait until element idx of the partition of signal owned by the
+ *  calling rank compares to value as cmp, one of RemoteCmpEq, ...,
+ *  RemoteCmpLe.  Data delivered by the remote_put_signal that set it can
+ *  then be read from the local partition.
+ */
+template <class SignalView>
+void remote_wait_until(const SignalView& signal, const size_t idx,
+                       const int cmp, const uint64_t value) {
+  Impl::check_remote_signal(signal, Impl::remote_my_pe(signal), idx);
+  Impl::RemoteBlockTransfer<typename SignalView::traits::specialize>::
+      wait_until(signal, idx, cmp, value);
+}
+
+/**\brief Value of a remote element read with remote_get_async.
+ *
+ *  The value is valid once wait_all() or fence() of the remote space has
+ *  returned.  Copies share the same storage.
+ */
+template <class T>
+class RemoteFuture {
+ public:
+  RemoteFuture() : m_value(new T()) {}
+
+  const T& get() const { return *m_value; }
+
+  T* data() const { return m_value.get(); }
+
+ private:
+  std::shared_ptr<T> m_value;
+};
+
+/**\brief Start reading element (i...) of the partition owned by rank pe,
+ *  indexed as src(pe, i...).  Completed by wait_all() of the remote space.
+ */
+template <class RemoteView, class... Idx>
+RemoteFuture<typename RemoteView::non_const_value_type> remote_get_async(
+    const RemoteView& src, const int pe, Idx... idx) {
+  RemoteFuture<typename RemoteView::non_const_value_type> future;
+  src(pe, idx...).load_async(*future.data());
+  return future;
+}
+
+/**\brief Start copying elements [range.first, range.second) of the
+ *  partition owned by rank pe into the contiguous local view dst.  dst must
+ *  not be accessed until wait_all() of the remote space has returned.
+ */
+template <class LocalView, class RemoteView>
+void remote_get_async(
+    const LocalView& dst, const RemoteView& src, const int pe,
+    const Kokkos::pair<size_t, size_t>& range,
+    typename std::enable_if<Kokkos::is_view<RemoteView>::value>::type* =
+        nullptr) {
+  static_assert(!std::is_const<typename LocalView::value_type>::value,
+                "Destination of remote_get_async must not be const");
+  Impl::check_remote_block_transfer(dst, src, pe, range);
+  Impl::RemoteBlockTransfer<typename RemoteView::traits::specialize>::
+      get_async(dst.data(), src, pe, range.first, range.second - range.first);
+}
+
+template <class LocalView, class RemoteView>
+void remote_get_async(
+    const LocalView& dst, const RemoteView& src, const int pe,
+    typename std::enable_if<Kokkos::is_view<RemoteView>::value>::type* =
+        nullptr) {
+  remote_get_async(
+      dst, src, pe,
+      Kokkos::pair<size_t, size_t>(0, Impl::remote_partition_span(src, pe)));
+}
+
+/**\brief Complete the operations issued on view.
+ *
+ *  Collective over the ranks of the view like the fence() of its space, but
+ *  leaves other views alone where the backend tracks operations per view.
+ *  MPISpace views allocated from the symmetric heap share its window and
+ *  complete together.
+ *
+ *  OpenSHMEM and NVSHMEM complete operations per PE, not per symmetric
+ *  object.  On SHMEMSpace and NVSHMEMSpace this is the global fence of the
+ *  space: it completes the operations on all views and is collective over
+ *  all PEs, or over the team of a SHMEMSpace created from a team.
+ */
+template <class RemoteView>
+void fence(const RemoteView& view,
+           typename std::enable_if<Kokkos::is_view<RemoteView>::value>::type* =
+               nullptr) {
+  RemoteView::traits::specialize::backend_type::fence(
+      view.impl_map().handle());
+}
+
+}  // namespace Experimental
+
 }  // namespace Kokkos
 
+#include <impl/Kokkos_RemoteSpaces_DeepCopy.hpp>
+#include <impl/Kokkos_RemoteSpaces_Subview.hpp>
+#include <impl/Kokkos_RemoteSpaces_ViewMapping.hpp>
+
 #if defined(KOKKOS_ENABLE_NVSHMEMSPACE)
 #include <impl/Kokkos_NVSHMEM_ViewMapping.hpp>
 #endif
@@ -51,6 +51,7 @@
 
 #include <Kokkos_Core_fwd.hpp>
 #include <Kokkos_Concepts.hpp>
+#include <Kokkos_HostSpace.hpp>
 #include <Kokkos_MemoryTraits.hpp>
 
 #include <impl/Kokkos_Traits.hpp>
@@ -234,15 +235,7 @@ struct VerifyExecutionCanAccessMemorySpace<Kokkos::HostSpace,
   inline static void verify(const void*) {}
 };
 
-template <class ExecutionSpace>
-struct DeepCopy<QUOSpace, QUOSpace, ExecutionSpace> {
-  DeepCopy(void* dst, const void* src, size_t n) { memcpy(dst, src, n); }
-
-  DeepCopy(const ExecutionSpace& exec, void* dst, const void* src, size_t n) {
-    exec.fence();
-    memcpy(dst, src, n);
-  }
-};
+KOKKOS_IMPL_REMOTE_SPACE_HOST_DEEP_COPY(QUOSpace)
 
 }  // namespace Impl
 
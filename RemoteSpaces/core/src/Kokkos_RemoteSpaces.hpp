@@ -4,6 +4,31 @@
 namespace Kokkos {
 enum { Monolithic, Symmetric, Asymmetric };
 
-}
+namespace Impl {
+// Defined in impl/Kokkos_RemoteSpaces_DeepCopy.hpp
+template <class ExecutionSpace>
+struct RemoteSpaceHostDeepCopy;
+}  // namespace Impl
+
+}  // namespace Kokkos
+
+// DeepCopy within the host-accessible remote space SPACE and between it and
+// HostSpace, to be expanded in namespace Kokkos::Impl
+#define KOKKOS_IMPL_REMOTE_SPACE_HOST_DEEP_COPY(SPACE)                      \
+  template <class ExecutionSpace>                                           \
+  struct DeepCopy<SPACE, SPACE, ExecutionSpace>                             \
+      : RemoteSpaceHostDeepCopy<ExecutionSpace> {                           \
+    using RemoteSpaceHostDeepCopy<ExecutionSpace>::RemoteSpaceHostDeepCopy; \
+  };                                                                        \
+  template <class ExecutionSpace>                                           \
+  struct DeepCopy<HostSpace, SPACE, ExecutionSpace>                         \
+      : RemoteSpaceHostDeepCopy<ExecutionSpace> {                           \
+    using RemoteSpaceHostDeepCopy<ExecutionSpace>::RemoteSpaceHostDeepCopy; \
+  };                                                                        \
+  template <class ExecutionSpace>                                           \
+  struct DeepCopy<SPACE, HostSpace, ExecutionSpace>                         \
+      : RemoteSpaceHostDeepCopy<ExecutionSpace> {                           \
+    using RemoteSpaceHostDeepCopy<ExecutionSpace>::RemoteSpaceHostDeepCopy; \
+  };
 
 #endif
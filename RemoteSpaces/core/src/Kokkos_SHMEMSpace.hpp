@@ -44,13 +44,16 @@
 #ifndef KOKKOS_SHMEMSPACE_HPP
 #define KOKKOS_SHMEMSPACE_HPP
 
+#include <cstdint>
 #include <cstring>
 #include <string>
 #include <iosfwd>
+#include <vector>
 #include <typeinfo>
 
 #include <Kokkos_Core_fwd.hpp>
 #include <Kokkos_Concepts.hpp>
+#include <Kokkos_HostSpace.hpp>
 #include <Kokkos_MemoryTraits.hpp>
 
 #include <impl/Kokkos_Traits.hpp>
@@ -60,6 +63,16 @@
 #include <Kokkos_RemoteSpaces.hpp>
 #include <mpi.h>
 #include <shmem.h>
+
+// Teams, team-based collectives and put-with-signal were introduced in
+// OpenSHMEM 1.5
+#if defined(SHMEM_MAJOR_VERSION) && defined(SHMEM_MINOR_VERSION)
+#if SHMEM_MAJOR_VERSION > 1 || \
+    (SHMEM_MAJOR_VERSION == 1 && SHMEM_MINOR_VERSION >= 5)
+#define KOKKOS_ENABLE_SHMEM_TEAMS
+#define KOKKOS_ENABLE_SHMEM_PUT_SIGNAL
+#endif
+#endif
 /*--------------------------------------------------------------------------*/
 
 namespace Kokkos {
@@ -97,6 +110,25 @@ class SHMEMSpace {
 
   explicit SHMEMSpace(const MPI_Comm&);
 
+#ifdef KOKKOS_ENABLE_SHMEM_TEAMS
+  /**\brief Partition views over the PEs of team.
+   *
+   *  Views are indexed by team PE number and fence() synchronizes the team
+   *  only.  shmem_malloc is collective over all PEs, so PEs outside of the
+   *  team take part in the allocation with SHMEM_TEAM_INVALID, as returned
+   *  to them by shmem_team_split_strided, and get views without partitions.
+   */
+  explicit SHMEMSpace(const shmem_team_t& team);
+
+  shmem_team_t team;
+#endif
+
+  /**\brief Number of PEs of the team of this space. */
+  int num_pes() const;
+
+  /**\brief Number of the calling PE in the team of this space. */
+  int my_pe() const;
+
   void* allocate(const size_t arg_alloc_size) const;
 
   void deallocate(void* const arg_alloc_ptr, const size_t arg_alloc_size) const;
@@ -109,12 +141,35 @@ class SHMEMSpace {
   /**\brief Return Name of the MemorySpace */
   static constexpr const char* name() { return m_name; }
 
+  /**\brief Complete the operations of this PE and synchronize the PEs of
+   *  the team of this space. */
   void fence();
 
+  /**\brief Complete the non-blocking gets and puts issued by this PE.
+   *
+   *  Only waits for local completion with shmem_quiet, without a barrier,
+   *  so other PEs are not synchronized.  Use fence() where remote PEs must
+   *  observe the writes before they proceed.
+   */
+  void wait_all();
+
   int* rank_list;
   int allocation_mode;
   int64_t extent;
 
+  /**\brief Issue element puts as non-blocking shmem_putmem_nbi.
+   *
+   *  Values are copied into a per-thread staging buffer, which must stay
+   *  untouched until the puts complete at wait_all() or fence().  A thread
+   *  that has staged chunk_size bytes completes its puts with shmem_quiet
+   *  and reuses its buffer.
+   */
+  static void set_nonblocking_puts(const bool enable,
+                                   const size_t chunk_size = 65536);
+
+  static bool nonblocking_puts;
+  static size_t nonblocking_chunk_size;
+
   void impl_set_rank_list(int* const);
   void impl_set_allocation_mode(const int);
   void impl_set_extent(int64_t N);
@@ -124,6 +179,20 @@ class SHMEMSpace {
   friend class Kokkos::Impl::SharedAllocationRecord<Kokkos::SHMEMSpace, void>;
 };
 
+namespace Impl {
+
+void shmem_stage_put(void* dst, const void* val, const size_t size,
+                     const int pe);
+
+/* Brackets a shmem_quiet or barrier: staging memory of the non-blocking
+ * puts issued before shmem_begin_staged_release() is reused by its owning
+ * thread after the matching shmem_end_staged_release(). */
+uint64_t shmem_begin_staged_release();
+
+void shmem_end_staged_release(const uint64_t ticket);
+
+}  // namespace Impl
+
 }  // namespace Kokkos
 
 //----------------------------------------------------------------------------
@@ -163,8 +232,6 @@ class SharedAllocationRecord<Kokkos::SHMEMSpace, void>
    */
   static RecordBase s_root_record;
 
-  const Kokkos::SHMEMSpace m_space;
-
  protected:
   ~SharedAllocationRecord();
   SharedAllocationRecord() = default;
@@ -175,6 +242,20 @@ class SharedAllocationRecord<Kokkos::SHMEMSpace, void>
       const RecordBase::function_type arg_dealloc = &deallocate);
 
  public:
+  const Kokkos::SHMEMSpace m_space;
+
+  /* Offsets of the partitions of all PEs along the leading partition
+   * extent, followed by the total.  Empty for symmetric allocations. */
+  std::vector<int64_t> partition_offsets;
+
+  /* Partitions of all PEs as returned by shmem_ptr, NULL for PEs that are
+   * not directly addressable.  Empty if no PE is. */
+  std::vector<void*> peer_ptrs;
+
+  /* PE number in the world team of every team PE.  Empty for allocations
+   * over all PEs. */
+  std::vector<int> team_pes;
+
   inline std::string get_label() const {
     return std::string(RecordBase::head()->m_label);
   }
@@ -232,15 +313,7 @@ struct VerifyExecutionCanAccessMemorySpace<Kokkos::HostSpace,
   inline static void verify(const void*) {}
 };
 
-template <class ExecutionSpace>
-struct DeepCopy<SHMEMSpace, SHMEMSpace, ExecutionSpace> {
-  DeepCopy(void* dst, const void* src, size_t n) { memcpy(dst, src, n); }
-
-  DeepCopy(const ExecutionSpace& exec, void* dst, const void* src, size_t n) {
-    exec.fence();
-    memcpy(dst, src, n);
-  }
-};
+KOKKOS_IMPL_REMOTE_SPACE_HOST_DEEP_COPY(SHMEMSpace)
 
 }  // namespace Impl
 
@@ -44,17 +44,228 @@
 #include <Kokkos_Core.hpp>
 #include <Kokkos_MPISpace.hpp>
 #include <mpi.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <algorithm>
+#include <climits>
 
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 
 namespace Kokkos {
 
-MPI_Win MPISpace::current_win;
-std::vector<MPI_Win> MPISpace::mpi_windows;
+namespace Impl {
+
+void MPIWindowRegistry::insert(const void *arg_alloc_ptr,
+                               const MPIWindows &arg_windows) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_list.emplace_back(arg_alloc_ptr, arg_windows);
+  m_map[arg_alloc_ptr] = std::prev(m_list.end());
+}
+
+bool MPIWindowRegistry::find(const void *arg_alloc_ptr,
+                             MPIWindows &arg_windows) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_map.find(arg_alloc_ptr);
+  if (it == m_map.end()) return false;
+  arg_windows = it->second->second;
+  return true;
+}
+
+bool MPIWindowRegistry::erase(const void *arg_alloc_ptr,
+                              MPIWindows &arg_windows) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_map.find(arg_alloc_ptr);
+  if (it == m_map.end()) return false;
+  arg_windows = it->second->second;
+  m_list.erase(it->second);
+  m_map.erase(it);
+  return true;
+}
+
+std::vector<MPIWindows> MPIWindowRegistry::windows() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  std::vector<MPIWindows> windows;
+  windows.reserve(m_list.size());
+  for (auto &entry : m_list) windows.push_back(entry.second);
+  return windows;
+}
+
+size_t MPIWindowRegistry::size() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_list.size();
+}
+
+namespace {
+
+constexpr size_t mpi_huge_page_size = size_t(2) << 20;
+
+// Hints that let MPI select its faster RMA paths
+MPI_Info mpi_window_info(const bool same_size) {
+  MPI_Info info;
+  MPI_Info_create(&info);
+  MPI_Info_set(info, "same_disp_unit", "true");
+  if (same_size) MPI_Info_set(info, "same_size", "true");
+  if (MPISpace::relaxed_accumulate_ordering)
+    MPI_Info_set(info, "accumulate_ordering", "none");
+  return info;
+}
+
+// Maps size bytes from explicit huge pages, or from a huge page aligned
+// mapping advised for transparent huge pages if none are reserved
+char *mpi_map_huge_pages(const size_t size, MPIWindows &windows) {
+  windows.mem_size =
+      (size + mpi_huge_page_size - 1) & ~(mpi_huge_page_size - 1);
+#ifdef MAP_HUGETLB
+  windows.mem = mmap(NULL, windows.mem_size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  if (windows.mem != MAP_FAILED) return static_cast<char *>(windows.mem);
+#endif
+  windows.mem_size += mpi_huge_page_size;
+  windows.mem = mmap(NULL, windows.mem_size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (windows.mem == MAP_FAILED)
+    Kokkos::abort("MPISpace failed to map window memory.");
+  const uintptr_t addr = reinterpret_cast<uintptr_t>(windows.mem);
+  char *base           = reinterpret_cast<char *>(
+      (addr + mpi_huge_page_size - 1) & ~(mpi_huge_page_size - 1));
+#ifdef MADV_HUGEPAGE
+  madvise(base, windows.mem_size - mpi_huge_page_size, MADV_HUGEPAGE);
+#endif
+  return base;
+}
+
+}  // namespace
+
+MPIWindows mpi_create_windows(const size_t size, const MPI_Comm &comm,
+                              void **ptr, const bool same_size) {
+  MPIWindows windows = {MPI_WIN_NULL, MPI_WIN_NULL, comm, NULL, NULL, 0,
+                        NULL};
+  MPI_Info info      = mpi_window_info(same_size);
+  if (MPISpace::shared_memory_windows) {
+    MPI_Comm node_comm;
+    MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL,
+                        &node_comm);
+    MPI_Info_set(info, "alloc_shared_noncontig", "true");
+    MPI_Win_allocate_shared(size, 1, info, node_comm, ptr, &windows.shm_win);
+    MPI_Info_delete(info, "alloc_shared_noncontig");
+    MPI_Win_create(*ptr, size, 1, info, comm, &windows.win);
+    MPI_Comm_free(&node_comm);
+  } else if (MPISpace::huge_pages) {
+    *ptr = mpi_map_huge_pages(size, windows);
+    MPI_Win_create(*ptr, size, 1, info, comm, &windows.win);
+  } else {
+    MPI_Win_allocate(size, 1, info, comm, ptr, &windows.win);
+  }
+  MPI_Info_free(&info);
+  windows.base = static_cast<char *>(*ptr);
+  // Direct stores to shared-memory windows and local stores in the separate
+  // memory model need a fence to become visible, so these windows are never
+  // skipped
+  int *model, flag;
+  MPI_Win_get_attr(windows.win, MPI_WIN_MODEL, &model, &flag);
+  if (windows.shm_win == MPI_WIN_NULL && flag && *model == MPI_WIN_UNIFIED)
+    windows.dirty = new std::atomic<bool>(false);
+  // Both RMA modes keep the window in one passive-target epoch so that
+  // value-returning operations can complete on their own.  Only fence()
+  // differs between them.
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, windows.win);
+  return windows;
+}
+
+namespace {
+
+std::mutex mpi_requests_mutex;
+std::vector<MPI_Request> mpi_requests;
+
+}  // namespace
+
+void mpi_track_request(const MPI_Request request) {
+  std::lock_guard<std::mutex> lock(mpi_requests_mutex);
+  mpi_requests.push_back(request);
+}
+
+void mpi_wait_requests() {
+  std::vector<MPI_Request> requests;
+  {
+    std::lock_guard<std::mutex> lock(mpi_requests_mutex);
+    requests.swap(mpi_requests);
+  }
+  if (!requests.empty())
+    MPI_Waitall(int(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+}
+
+void mpi_free_windows(MPIWindows &windows) {
+  mpi_flush_aggregated_puts(windows.win);
+  mpi_wait_requests();
+  // Close the access epoch so that the flushed puts complete before the free
+  MPI_Win_unlock_all(windows.win);
+  mpi_release_aggregated_puts(std::vector<MPI_Win>(1, windows.win));
+  MPI_Win_free(&windows.win);
+  if (windows.shm_win != MPI_WIN_NULL) MPI_Win_free(&windows.shm_win);
+  if (windows.mem) munmap(windows.mem, windows.mem_size);
+  delete windows.dirty;
+  windows.dirty = NULL;
+}
+
+namespace {
+
+void mpi_flush_window(const MPI_Win win, std::atomic<bool> *dirty) {
+  MPI_Win_flush_all(win);
+  MPI_Win_sync(win);
+  if (dirty) dirty->store(false, std::memory_order_relaxed);
+}
+
+// Flushing is local, so every rank only flushes the windows it has
+// operations pending on.  In active-target mode the barrier then orders
+// them before the accesses of all ranks after the fence, and the second
+// sync makes the updates of other ranks visible to local loads.
+void mpi_fence_dirty_windows(const std::vector<MPIWindows> &windows,
+                             const MPI_Comm &comm) {
+  for (size_t i = 0; i < windows.size(); i++)
+    if (!windows[i].dirty || windows[i].dirty->load(std::memory_order_relaxed))
+      mpi_flush_window(windows[i].win, windows[i].dirty);
+  if (MPISpace::rma_mode == MPISpace::ActiveTarget) {
+    MPI_Barrier(comm);
+    for (size_t i = 0; i < windows.size(); i++) MPI_Win_sync(windows[i].win);
+  }
+}
+
+}  // namespace
+
+void mpi_fence_window(const MPI_Win win, const MPI_Comm &comm,
+                      std::atomic<bool> *dirty) {
+  if (win == MPI_WIN_NULL) return;
+  mpi_flush_aggregated_puts(win);
+  mpi_wait_requests();
+  mpi_flush_window(win, dirty);
+  mpi_release_aggregated_puts(std::vector<MPI_Win>(1, win));
+  if (MPISpace::rma_mode == MPISpace::ActiveTarget) {
+    MPI_Barrier(comm);
+    MPI_Win_sync(win);
+  }
+}
+
+}  // namespace Impl
+
+Impl::MPIWindowRegistry MPISpace::window_registry;
+Impl::MPISymmetricHeap MPISpace::symmetric_heap;
+bool MPISpace::put_aggregation            = false;
+size_t MPISpace::put_aggregation_threshold = 65536;
+int MPISpace::rma_mode                     = MPISpace::ActiveTarget;
+bool MPISpace::shared_memory_windows       = false;
+bool MPISpace::huge_pages                  = false;
+bool MPISpace::relaxed_accumulate_ordering = false;
 
 /* Default allocation mechanism */
-MPISpace::MPISpace() : rank_list(NULL), allocation_mode(Symmetric) {}
+MPISpace::MPISpace()
+    : comm(MPI_COMM_WORLD),
+      rank_list(NULL),
+      allocation_mode(Symmetric),
+      extent(0) {}
+
+MPISpace::MPISpace(const MPI_Comm &comm_)
+    : comm(comm_), rank_list(NULL), allocation_mode(Symmetric), extent(0) {}
 
 void MPISpace::impl_set_rank_list(int *const rank_list_) {
   rank_list = rank_list_;
@@ -66,6 +277,36 @@ void MPISpace::impl_set_allocation_mode(const int allocation_mode_) {
 
 void MPISpace::impl_set_extent(const int64_t extent_) { extent = extent_; }
 
+void MPISpace::set_put_aggregation(const bool enable, const size_t threshold) {
+  if (put_aggregation && !enable) Impl::mpi_flush_aggregated_puts();
+  // MPI counts buffered bytes in int, leave room for the element that
+  // crosses the threshold
+  put_aggregation           = enable;
+  put_aggregation_threshold = std::min(threshold, size_t(INT_MAX / 2));
+}
+
+void MPISpace::set_rma_mode(const int mode) {
+  if (mode == rma_mode) return;
+  if (window_registry.size() != 0 || symmetric_heap.active())
+    Kokkos::abort("MPISpace RMA mode cannot change while windows are live.");
+  rma_mode = mode;
+}
+
+void MPISpace::set_shared_memory_windows(const bool enable) {
+  shared_memory_windows = enable;
+}
+
+void MPISpace::set_huge_pages(const bool enable) { huge_pages = enable; }
+
+void MPISpace::set_relaxed_accumulate_ordering(const bool enable) {
+  relaxed_accumulate_ordering = enable;
+}
+
+void MPISpace::set_symmetric_heap(const size_t size) {
+  symmetric_heap.destroy();
+  if (size) symmetric_heap.create(size, MPI_COMM_WORLD);
+}
+
 void *MPISpace::allocate(const size_t arg_alloc_size) const {
   static_assert(sizeof(void *) == sizeof(uintptr_t),
                 "Error sizeof(void*) != sizeof(uintptr_t)");
@@ -79,50 +320,59 @@ void *MPISpace::allocate(const size_t arg_alloc_size) const {
 
   void *ptr = 0;
   if (arg_alloc_size) {
-    if (allocation_mode == Kokkos::Symmetric) {
-      current_win = MPI_WIN_NULL;
-      MPI_Win_allocate(arg_alloc_size, 1, MPI_INFO_NULL, MPI_COMM_WORLD, &ptr,
-                       &current_win);
-      int i = -1;
-      for (i = 0; i < mpi_windows.size(); i++)
-        if (mpi_windows[i] == MPI_WIN_NULL) break;
-      if (i == mpi_windows.size())
-        mpi_windows.push_back(current_win);
-      else
-        mpi_windows[i] = current_win;
-    } else {
-      Kokkos::abort("MPISpace only supports symmetric allocation policy.");
+    if (allocation_mode != Kokkos::Symmetric &&
+        allocation_mode != Kokkos::Asymmetric)
+      Kokkos::abort(
+          "MPISpace only supports symmetric and asymmetric allocation "
+          "policies.");
+    // Heap offsets only agree across ranks if every rank allocates the
+    // same size
+    if (allocation_mode == Kokkos::Symmetric &&
+        comm == symmetric_heap.windows.comm)
+      ptr = symmetric_heap.allocate(arg_alloc_size);
+    if (ptr) return ptr;
+    // Huge page windows start on a page boundary.  Placing the header at
+    // the end of the first page aligns the payload of the allocation.
+    size_t pad = 0;
+    if (huge_pages && !shared_memory_windows) {
+      const size_t page = sysconf(_SC_PAGESIZE);
+      pad = (page - sizeof(Impl::SharedAllocationHeader) % page) % page;
     }
+    Impl::MPIWindows windows = Impl::mpi_create_windows(
+        pad + arg_alloc_size, comm, &ptr, allocation_mode == Kokkos::Symmetric);
+    ptr = static_cast<char *>(ptr) + pad;
+    window_registry.insert(ptr, windows);
   }
   return ptr;
 }
 
-void MPISpace::deallocate(void *const, const size_t) const {
-  int assert     = 0;
-  int last_valid = -1;
-  for (last_valid = 0; last_valid < mpi_windows.size(); last_valid++)
-    if (mpi_windows[last_valid] == MPI_WIN_NULL) break;
-  last_valid--;
-  for (int i = 0; i < mpi_windows.size(); i++)
-    if (mpi_windows[i] == current_win) {
-      mpi_windows[i]          = mpi_windows[last_valid];
-      mpi_windows[last_valid] = MPI_WIN_NULL;
-      break;
-    }
+void MPISpace::deallocate(void *const arg_alloc_ptr, const size_t) const {
+  // Operations still in flight to a heap block complete at the next fence
+  if (symmetric_heap.deallocate(arg_alloc_ptr)) return;
 
-  MPI_Win_free(&current_win);
-  current_win = MPI_WIN_NULL;
+  Impl::MPIWindows windows;
+  if (!window_registry.erase(arg_alloc_ptr, windows)) return;
+  Impl::mpi_free_windows(windows);
 }
 
 void MPISpace::fence() {
-  int assert = 0;
-  for (int i = 0; i < mpi_windows.size(); i++)
-    if (mpi_windows[i] != MPI_WIN_NULL)
-      MPI_Win_fence(assert, mpi_windows[i]);
-    else
-      break;
+  if (put_aggregation) Impl::mpi_flush_aggregated_puts();
+  Impl::mpi_wait_requests();
+  // Only synchronize the windows of this space's communicator, in the same
+  // order on every rank
+  std::vector<Impl::MPIWindows> windows;
+  if (symmetric_heap.active() && symmetric_heap.windows.comm == comm)
+    windows.push_back(symmetric_heap.windows);
+  for (auto &entry : window_registry.windows())
+    if (entry.comm == comm) windows.push_back(entry);
+  Impl::mpi_fence_dirty_windows(windows, comm);
+  std::vector<MPI_Win> wins;
+  for (auto &entry : windows) wins.push_back(entry.win);
+  Impl::mpi_release_aggregated_puts(wins);
 }
 
+void MPISpace::wait_all() { Impl::mpi_wait_requests(); }
+
 }  // namespace Kokkos
 
 //----------------------------------------------------------------------------
@@ -147,7 +397,6 @@ SharedAllocationRecord<Kokkos::MPISpace, void>::~SharedAllocationRecord() {
         RecordBase::m_alloc_ptr->m_label, data(), size());
   }
 #endif
-  m_space.current_win = win;
   m_space.deallocate(SharedAllocationRecord<void, void>::m_alloc_ptr,
                      SharedAllocationRecord<void, void>::m_alloc_size);
 }
@@ -178,7 +427,56 @@ SharedAllocationRecord<Kokkos::MPISpace, void>::SharedAllocationRecord(
       static_cast<SharedAllocationRecord<void, void> *>(this);
   strncpy(RecordBase::m_alloc_ptr->m_label, arg_label.c_str(),
           SharedAllocationHeader::maximum_label_length);
-  win = m_space.current_win;
+  Impl::MPIWindows windows = {MPI_WIN_NULL, MPI_WIN_NULL, MPI_COMM_NULL};
+  base_offset               = 0;
+  if (MPISpace::symmetric_heap.contains(RecordBase::m_alloc_ptr)) {
+    windows     = MPISpace::symmetric_heap.windows;
+    base_offset =
+        MPISpace::symmetric_heap.displacement(RecordBase::m_alloc_ptr);
+  } else if (MPISpace::window_registry.find(RecordBase::m_alloc_ptr,
+                                           windows)) {
+    base_offset =
+        reinterpret_cast<char *>(RecordBase::m_alloc_ptr) - windows.base;
+  }
+  win     = windows.win;
+  shm_win = windows.shm_win;
+  dirty   = windows.dirty;
+
+  if (shm_win != MPI_WIN_NULL) {
+    // Translate every rank into the node-local group to find its partition
+    MPI_Group comm_group, node_group;
+    int num_ranks;
+    MPI_Comm_size(m_space.comm, &num_ranks);
+    MPI_Comm_group(m_space.comm, &comm_group);
+    MPI_Win_get_group(shm_win, &node_group);
+    std::vector<int> comm_ranks(num_ranks), node_ranks(num_ranks);
+    for (int r = 0; r < num_ranks; r++) comm_ranks[r] = r;
+    MPI_Group_translate_ranks(comm_group, num_ranks, comm_ranks.data(),
+                              node_group, node_ranks.data());
+    peer_ptrs.assign(num_ranks, NULL);
+    for (int r = 0; r < num_ranks; r++) {
+      if (node_ranks[r] == MPI_UNDEFINED) continue;
+      MPI_Aint size;
+      int disp_unit;
+      char *base;
+      MPI_Win_shared_query(shm_win, node_ranks[r], &size, &disp_unit, &base);
+      peer_ptrs[r] = base + base_offset + sizeof(SharedAllocationHeader);
+    }
+    MPI_Group_free(&node_group);
+    MPI_Group_free(&comm_group);
+  }
+
+  if (m_space.allocation_mode == Kokkos::Asymmetric) {
+    int num_ranks;
+    MPI_Comm_size(m_space.comm, &num_ranks);
+    std::vector<int64_t> extents(num_ranks);
+    int64_t extent = m_space.extent;
+    MPI_Allgather(&extent, 1, MPI_INT64_T, extents.data(), 1, MPI_INT64_T,
+                  m_space.comm);
+    partition_offsets.assign(num_ranks + 1, 0);
+    for (int r = 0; r < num_ranks; r++)
+      partition_offsets[r + 1] = partition_offsets[r] + extents[r];
+  }
 }
 
 //----------------------------------------------------------------------------
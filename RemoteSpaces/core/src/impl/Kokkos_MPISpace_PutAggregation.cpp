@@ -0,0 +1,284 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  H. Carter Edwards (hcedwar@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_MPISpace.hpp>
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+
+namespace Kokkos {
+namespace Impl {
+
+namespace {
+
+/* Pending puts to one (window, rank) pair.  Element values are packed
+ * back-to-back into data; runs describes where each contiguous piece
+ * lands in the target window.  Runs never overlap, so the bytes of one
+ * put never target the same location twice.  [low, high) bounds them.
+ * [issued_low, issued_high) bounds the puts issued since the target last
+ * completed them, empty if issued_low == issued_high. */
+struct MPIPutBuffer {
+  MPI_Win win;
+  int pe;
+  std::vector<char> data;
+  std::vector<MPI_Aint> disps;
+  std::vector<int> lengths;
+  MPI_Aint low;
+  MPI_Aint high;
+  MPI_Aint issued_low  = 0;
+  MPI_Aint issued_high = 0;
+};
+
+/* The owning thread and flushes from other threads both take mutex */
+struct MPIThreadPutBuffers {
+  std::mutex mutex;
+  std::unordered_map<uint64_t, MPIPutBuffer> buffers;
+  /* Staging memory of issued puts per window; must stay valid until the
+   * window is flushed */
+  std::vector<std::pair<MPI_Win, std::vector<char>>> retired;
+};
+
+std::mutex put_buffers_mutex;
+std::vector<std::unique_ptr<MPIThreadPutBuffers>> put_buffers;
+
+MPIThreadPutBuffers &thread_put_buffers() {
+  thread_local MPIThreadPutBuffers *buffers = nullptr;
+  if (buffers == nullptr) {
+    std::lock_guard<std::mutex> lock(put_buffers_mutex);
+    put_buffers.emplace_back(new MPIThreadPutBuffers());
+    buffers = put_buffers.back().get();
+  }
+  return *buffers;
+}
+
+uint64_t put_buffer_key(const MPI_Win win, const int pe) {
+  return (uint64_t(uint32_t(MPI_Win_c2f(win))) << 32) | uint32_t(pe);
+}
+
+void issue(MPIThreadPutBuffers &buffers, MPIPutBuffer &buffer) {
+  if (buffer.data.empty()) return;
+
+  /* A put overlapping one issued earlier in the epoch would leave the
+   * target undefined, so the earlier ones must complete first */
+  if (buffer.low < buffer.issued_high && buffer.issued_low < buffer.high) {
+    MPI_Win_flush(buffer.pe, buffer.win);
+    buffer.issued_low  = 0;
+    buffer.issued_high = 0;
+  }
+  if (buffer.issued_low == buffer.issued_high) {
+    buffer.issued_low  = buffer.low;
+    buffer.issued_high = buffer.high;
+  } else {
+    buffer.issued_low  = std::min(buffer.issued_low, buffer.low);
+    buffer.issued_high = std::max(buffer.issued_high, buffer.high);
+  }
+
+  const int size = buffer.data.size();
+  if (buffer.disps.size() == 1) {
+    MPI_Put(buffer.data.data(), size, MPI_BYTE, buffer.pe, buffer.disps[0],
+            size, MPI_BYTE, buffer.win);
+  } else {
+    MPI_Datatype target_type;
+    MPI_Type_create_hindexed(buffer.disps.size(), buffer.lengths.data(),
+                             buffer.disps.data(), MPI_BYTE, &target_type);
+    MPI_Type_commit(&target_type);
+    MPI_Put(buffer.data.data(), size, MPI_BYTE, buffer.pe, 0, 1, target_type,
+            buffer.win);
+    MPI_Type_free(&target_type);
+  }
+
+  if (MPISpace::rma_mode == MPISpace::PassiveTarget) {
+    /* Local completion makes the staging memory reusable right away */
+    MPI_Win_flush_local(buffer.pe, buffer.win);
+    buffer.data.clear();
+  } else {
+    buffers.retired.emplace_back(buffer.win, std::vector<char>());
+    buffers.retired.back().second.swap(buffer.data);
+  }
+  buffer.disps.clear();
+  buffer.lengths.clear();
+}
+
+void append_run(MPIPutBuffer &buffer, const char *val, const size_t size,
+                const MPI_Aint disp) {
+  if (buffer.disps.empty()) {
+    buffer.low  = disp;
+    buffer.high = disp;
+  }
+  buffer.disps.push_back(disp);
+  buffer.lengths.push_back(size);
+  buffer.data.insert(buffer.data.end(), val, val + size);
+  buffer.low  = std::min(buffer.low, disp);
+  buffer.high = std::max(buffer.high, disp + MPI_Aint(size));
+}
+
+/* Bytes of the write covered by a run overwrite it in place, the others
+ * become new runs.  Two puts to overlapping targets in one epoch would
+ * leave the result undefined. */
+void fold_into_runs(MPIPutBuffer &buffer, const char *val, const size_t size,
+                    const MPI_Aint disp) {
+  const MPI_Aint end = disp + MPI_Aint(size);
+  std::vector<std::pair<MPI_Aint, MPI_Aint>> covered;
+  size_t offset = 0;
+  for (size_t r = 0; r < buffer.disps.size(); r++) {
+    const MPI_Aint run_begin = buffer.disps[r];
+    const MPI_Aint begin     = std::max(disp, run_begin);
+    const MPI_Aint stop      = std::min(end, run_begin + buffer.lengths[r]);
+    if (begin < stop) {
+      std::memcpy(buffer.data.data() + offset + (begin - run_begin),
+                  val + (begin - disp), stop - begin);
+      covered.emplace_back(begin, stop);
+    }
+    offset += buffer.lengths[r];
+  }
+
+  std::sort(covered.begin(), covered.end());
+  MPI_Aint next = disp;
+  for (const auto &piece : covered) {
+    if (piece.first > next)
+      append_run(buffer, val + (next - disp), piece.first - next, next);
+    next = piece.second;
+  }
+  if (next < end) append_run(buffer, val + (next - disp), end - next, next);
+}
+
+}  // namespace
+
+void mpi_aggregate_put(const void *val, const size_t size, const MPI_Aint disp,
+                       const int pe, const MPI_Win win) {
+  MPIThreadPutBuffers &buffers = thread_put_buffers();
+  std::lock_guard<std::mutex> lock(buffers.mutex);
+  MPIPutBuffer &buffer = buffers.buffers[put_buffer_key(win, pe)];
+  buffer.win           = win;
+  buffer.pe            = pe;
+  const char *bytes    = static_cast<const char *>(val);
+
+  if (buffer.disps.empty()) {
+    append_run(buffer, bytes, size, disp);
+  } else {
+    const MPI_Aint run_begin = buffer.disps.back();
+    const MPI_Aint run_end   = run_begin + buffer.lengths.back();
+    if (disp == run_end && run_end == buffer.high) {
+      /* Contiguous with the last run and past all others: extend it */
+      buffer.lengths.back() += size;
+      buffer.data.insert(buffer.data.end(), bytes, bytes + size);
+      buffer.high += size;
+    } else if (disp >= run_begin && disp + MPI_Aint(size) <= run_end) {
+      /* Overwrites data of the last run: update it in place */
+      std::memcpy(buffer.data.data() + buffer.data.size() - (run_end - disp),
+                  bytes, size);
+    } else if (disp >= buffer.high || disp + MPI_Aint(size) <= buffer.low) {
+      /* Outside of all runs: start a new run of the same target datatype */
+      append_run(buffer, bytes, size, disp);
+    } else {
+      fold_into_runs(buffer, bytes, size, disp);
+    }
+  }
+
+  if (buffer.data.size() >= MPISpace::put_aggregation_threshold)
+    issue(buffers, buffer);
+}
+
+void mpi_flush_thread_puts(const MPI_Win win, const int pe) {
+  MPIThreadPutBuffers &buffers = thread_put_buffers();
+  std::lock_guard<std::mutex> lock(buffers.mutex);
+  auto it = buffers.buffers.find(put_buffer_key(win, pe));
+  if (it != buffers.buffers.end()) issue(buffers, it->second);
+}
+
+void mpi_flush_aggregated_puts() {
+  std::lock_guard<std::mutex> lock(put_buffers_mutex);
+  for (auto &buffers : put_buffers) {
+    std::lock_guard<std::mutex> buffers_lock(buffers->mutex);
+    for (auto &buffer : buffers->buffers) issue(*buffers, buffer.second);
+  }
+}
+
+void mpi_flush_aggregated_puts(const MPI_Win win) {
+  std::lock_guard<std::mutex> lock(put_buffers_mutex);
+  for (auto &buffers : put_buffers) {
+    std::lock_guard<std::mutex> buffers_lock(buffers->mutex);
+    for (auto it = buffers->buffers.begin(); it != buffers->buffers.end();) {
+      if (it->second.win == win) {
+        issue(*buffers, it->second);
+        it = buffers->buffers.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+}
+
+void mpi_release_aggregated_puts(const std::vector<MPI_Win> &wins) {
+  auto flushed = [&](const MPI_Win win) {
+    return std::find(wins.begin(), wins.end(), win) != wins.end();
+  };
+  std::lock_guard<std::mutex> lock(put_buffers_mutex);
+  for (auto &buffers : put_buffers) {
+    std::lock_guard<std::mutex> buffers_lock(buffers->mutex);
+    auto &retired = buffers->retired;
+    retired.erase(
+        std::remove_if(retired.begin(), retired.end(),
+                       [&](const std::pair<MPI_Win, std::vector<char>> &r) {
+                         return flushed(r.first);
+                       }),
+        retired.end());
+    for (auto &buffer : buffers->buffers) {
+      if (!flushed(buffer.second.win)) continue;
+      buffer.second.issued_low  = 0;
+      buffer.second.issued_high = 0;
+    }
+  }
+}
+
+}  // namespace Impl
+}  // namespace Kokkos
@@ -0,0 +1,151 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  H. Carter Edwards (hcedwar@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_MPISpace.hpp>
+#include <mpi.h>
+
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+
+namespace Kokkos {
+namespace Impl {
+
+MPISymmetricHeap::MPISymmetricHeap() : m_base(NULL), m_size(0) {
+  windows.win     = MPI_WIN_NULL;
+  windows.shm_win = MPI_WIN_NULL;
+  windows.comm    = MPI_COMM_NULL;
+  windows.base    = NULL;
+  windows.mem     = NULL;
+  windows.dirty   = NULL;
+}
+
+void MPISymmetricHeap::create(const size_t arg_size, const MPI_Comm &arg_comm) {
+  if (active()) Kokkos::abort("MPISpace symmetric heap already exists.");
+
+  void *ptr = NULL;
+  windows   = mpi_create_windows(arg_size, arg_comm, &ptr, true);
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_base = static_cast<char *>(ptr);
+  m_size = arg_size;
+  m_free.clear();
+  m_used.clear();
+  m_free[0] = arg_size;
+}
+
+void MPISymmetricHeap::destroy() {
+  if (!active()) return;
+  if (live_allocations() != 0)
+    Kokkos::abort("MPISpace symmetric heap released with live allocations.");
+
+  mpi_free_windows(windows);
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_base       = NULL;
+  m_size       = 0;
+  windows.comm = MPI_COMM_NULL;
+  m_free.clear();
+}
+
+void *MPISymmetricHeap::allocate(const size_t arg_alloc_size) {
+  constexpr size_t alignment_mask = Kokkos::Impl::MEMORY_ALIGNMENT - 1;
+  const size_t size = (arg_alloc_size + alignment_mask) & ~alignment_mask;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_base) return NULL;
+  for (auto it = m_free.begin(); it != m_free.end(); ++it) {
+    if (it->second < size) continue;
+    const size_t offset    = it->first;
+    const size_t remaining = it->second - size;
+    m_free.erase(it);
+    if (remaining) m_free[offset + size] = remaining;
+    m_used[offset] = size;
+    return m_base + offset;
+  }
+  return NULL;
+}
+
+bool MPISymmetricHeap::deallocate(const void *arg_alloc_ptr) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_base || arg_alloc_ptr < m_base || arg_alloc_ptr >= m_base + m_size)
+    return false;
+
+  auto used = m_used.find(static_cast<const char *>(arg_alloc_ptr) - m_base);
+  if (used == m_used.end()) return false;
+  size_t offset = used->first;
+  size_t size   = used->second;
+  m_used.erase(used);
+
+  // Coalesce with the neighbouring free blocks
+  auto next = m_free.lower_bound(offset);
+  if (next != m_free.end() && offset + size == next->first) {
+    size += next->second;
+    next = m_free.erase(next);
+  }
+  if (next != m_free.begin()) {
+    auto prev = std::prev(next);
+    if (prev->first + prev->second == offset) {
+      offset = prev->first;
+      size += prev->second;
+    }
+  }
+  m_free[offset] = size;
+  return true;
+}
+
+bool MPISymmetricHeap::contains(const void *arg_alloc_ptr) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_base && arg_alloc_ptr >= m_base && arg_alloc_ptr < m_base + m_size;
+}
+
+MPI_Aint MPISymmetricHeap::displacement(const void *arg_alloc_ptr) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return static_cast<const char *>(arg_alloc_ptr) - m_base;
+}
+
+size_t MPISymmetricHeap::live_allocations() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_used.size();
+}
+
+}  // namespace Impl
+}  // namespace Kokkos
@@ -1,366 +1,350 @@
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <cstring>
 #include <type_traits>
 //----------------------------------------------------------------------------
 /** \brief  View mapping for non-specialized data type and standard layout */
 namespace Kokkos {
 namespace Impl {
 
-KOKKOS_INLINE_FUNCTION
-void mpi_type_p(const int val, int offset, const int pe, const MPI_Win& win) {
+/**\brief Maps a trivially copyable type to the MPI datatype of one element.
+ *
+ *  Arithmetic types and Kokkos::complex map to predefined datatypes, which
+ *  also makes them valid for MPI accumulate operations.  Any other type is
+ *  transferred as a contiguous block of bytes whose derived datatype is
+ *  created and committed on first use.
+ */
+template <class T, class Enable = void>
+struct MPIDataType {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "MPISpace value types must be trivially copyable");
+  enum { is_predefined = false };
+  static MPI_Datatype value() {
+    static const MPI_Datatype type = []() {
+      MPI_Datatype t;
+      MPI_Type_contiguous(sizeof(T), MPI_BYTE, &t);
+      MPI_Type_commit(&t);
+      return t;
+    }();
+    return type;
+  }
+};
+
+#define KOKKOS_IMPL_MPI_PREDEFINED_TYPE(T, MPI_T) \
+  template <>                                     \
+  struct MPIDataType<T> {                         \
+    enum { is_predefined = true };                \
+    static MPI_Datatype value() { return MPI_T; } \
+  };
+
+KOKKOS_IMPL_MPI_PREDEFINED_TYPE(char, MPI_CHAR)
+KOKKOS_IMPL_MPI_PREDEFINED_TYPE(signed char, MPI_SIGNED_CHAR)
+KOKKOS_IMPL_MPI_PREDEFINED_TYPE(unsigned char, MPI_UNSIGNED_CHAR)
+KOKKOS_IMPL_MPI_PREDEFINED_TYPE(short, MPI_SHORT)
+KOKKOS_IMPL_MPI_PREDEFINED_TYPE(unsigned short, MPI_UNSIGNED_SHORT)
+KOKKOS_IMPL_MPI_PREDEFINED_TYPE(int, MPI_INT)
+KOKKOS_IMPL_MPI_PREDEFINED_TYPE(unsigned int, MPI_UNSIGNED)
+KOKKOS_IMPL_MPI_PREDEFINED_TYPE(long, MPI_LONG)
+KOKKOS_IMPL_MPI_PREDEFINED_TYPE(unsigned long, MPI_UNSIGNED_LONG)
+KOKKOS_IMPL_MPI_PREDEFINED_TYPE(long long, MPI_LONG_LONG)
+KOKKOS_IMPL_MPI_PREDEFINED_TYPE(unsigned long long, MPI_UNSIGNED_LONG_LONG)
+KOKKOS_IMPL_MPI_PREDEFINED_TYPE(float, MPI_FLOAT)
+KOKKOS_IMPL_MPI_PREDEFINED_TYPE(double, MPI_DOUBLE)
+KOKKOS_IMPL_MPI_PREDEFINED_TYPE(long double, MPI_LONG_DOUBLE)
+KOKKOS_IMPL_MPI_PREDEFINED_TYPE(Kokkos::complex<float>, MPI_C_FLOAT_COMPLEX)
+KOKKOS_IMPL_MPI_PREDEFINED_TYPE(Kokkos::complex<double>, MPI_C_DOUBLE_COMPLEX)
+
+#undef KOKKOS_IMPL_MPI_PREDEFINED_TYPE
+
+// Flags the window of an operation for the next MPISpace::fence().  The
+// flag is only written once per epoch to keep its cache line shared.
+KOKKOS_INLINE_FUNCTION void mpi_mark_dirty(std::atomic<bool>* dirty) {
 #ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST
-  MPI_Put(&val, 1, MPI_INT, pe,
-          sizeof(SharedAllocationHeader) + offset * sizeof(int), 1, MPI_INT,
-          win);
+  if (dirty && !dirty->load(std::memory_order_relaxed))
+    dirty->store(true, std::memory_order_relaxed);
 #endif
 }
 
-KOKKOS_INLINE_FUNCTION
-void mpi_type_g(int& val, int offset, const int pe, const MPI_Win& win) {
+template <class T>
+KOKKOS_INLINE_FUNCTION void mpi_type_p(const T& val, const MPI_Aint disp,
+                                       const int pe, const MPI_Win& win) {
 #ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST
-  MPI_Get(&val, 1, MPI_INT, pe,
-          sizeof(SharedAllocationHeader) + offset * sizeof(int), 1, MPI_INT,
-          win);
+  if (MPISpace::put_aggregation)
+    mpi_aggregate_put(&val, sizeof(T), disp, pe, win);
+  else
+    MPI_Put(&val, 1, MPIDataType<T>::value(), pe, disp, 1,
+            MPIDataType<T>::value(), win);
 #endif
 }
 
-KOKKOS_INLINE_FUNCTION
-void mpi_type_p(const double val, int offset, const int pe,
-                const MPI_Win& win) {
+// A put followed by another operation on the same location in one epoch
+// is undefined unless the put is complete at the target in between.  Gets
+// and atomics therefore complete the puts of the calling thread to pe
+// first, including those still buffered for aggregation.
+KOKKOS_INLINE_FUNCTION void mpi_complete_puts(const int pe,
+                                              const MPI_Win& win) {
 #ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST
-  MPI_Put(&val, 1, MPI_DOUBLE, pe,
-          sizeof(SharedAllocationHeader) + offset * sizeof(double), 1,
-          MPI_DOUBLE, win);
+  if (MPISpace::put_aggregation) mpi_flush_thread_puts(win, pe);
+  MPI_Win_flush(pe, win);
 #endif
 }
 
-KOKKOS_INLINE_FUNCTION
-void mpi_type_g(double& val, int offset, const int pe, const MPI_Win& win) {
+template <class T>
+KOKKOS_INLINE_FUNCTION void mpi_type_g(T& val, const MPI_Aint disp,
+                                       const int pe, const MPI_Win& win) {
 #ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST
-  MPI_Get(&val, 1, MPI_DOUBLE, pe,
-          sizeof(SharedAllocationHeader) + offset * sizeof(double), 1,
-          MPI_DOUBLE, win);
+  MPI_Get(&val, 1, MPIDataType<T>::value(), pe, disp, 1,
+          MPIDataType<T>::value(), win);
+  MPI_Win_flush_local(pe, win);
 #endif
 }
 
-struct MPISpaceSpecializeTag {};
-
+// Completed by MPISpace::wait_all() in passive-target mode and by the next
+// fence() in active-target mode
 template <class T>
-struct MPIDataElement {
-  typedef const T const_value_type;
-  typedef T non_const_value_type;
-  const MPI_Win& win;
-  int offset;
-  int pe;
-  MPIDataElement(const MPI_Win& win_, int pe_, int i_)
-      : win(win_), offset(i_), pe(pe_) {}
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator=(const_value_type& val) const {
-    mpi_type_p(val, offset, pe, win);
-    return val;
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  void inc() const {
-    T val = T();
-    mpi_type_g(val, offset, pe, win);
-    val++;
-    mpi_type_p(val, offset, pe, win);
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  void dec() const {
-    T val = T();
-    mpi_type_g(val, offset, pe, win);
-    val--;
-    mpi_type_p(val, offset, pe, win);
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator++() const {
-    T val = T();
-    mpi_type_g(val, offset, pe, win);
-    val++;
-    mpi_type_p(val, offset, pe, win);
-    return val;
+KOKKOS_INLINE_FUNCTION void mpi_type_get_async(T* val, const size_t count,
+                                               const MPI_Aint disp,
+                                               const int pe,
+                                               const MPI_Win& win) {
+#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST
+  const MPI_Datatype type = MPIDataType<T>::value();
+  for (size_t i = 0; i < count; i += INT_MAX) {
+    const int n = std::min(count - i, size_t(INT_MAX));
+    if (MPISpace::rma_mode == MPISpace::PassiveTarget) {
+      MPI_Request request;
+      MPI_Rget(val + i, n, type, pe, disp + i * sizeof(T), n, type, win,
+               &request);
+      mpi_track_request(request);
+    } else {
+      MPI_Get(val + i, n, type, pe, disp + i * sizeof(T), n, type, win);
+    }
   }
+#endif
+}
 
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator--() const {
-    T val = T();
-    mpi_type_g(val, offset, pe, win);
-    val--;
-    mpi_type_p(val, offset, pe, win);
-    return val;
-  }
+template <class T>
+KOKKOS_INLINE_FUNCTION void mpi_type_acc(const T& val, const MPI_Aint disp,
+                                         const int pe, const MPI_Op op,
+                                         const MPI_Win& win) {
+  static_assert(MPIDataType<T>::is_predefined,
+                "MPISpace atomic operations require a predefined MPI type");
+#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST
+  MPI_Accumulate(&val, 1, MPIDataType<T>::value(), pe, disp, 1,
+                 MPIDataType<T>::value(), op, win);
+#endif
+}
 
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator++(int) const {
-    T val = T();
-    mpi_type_g(val, offset, pe, win);
-    val++;
-    mpi_type_p(val, offset, pe, win);
-    return val;
-  }
+template <class T>
+KOKKOS_INLINE_FUNCTION void mpi_type_fop(const T& val, T& result,
+                                         const MPI_Aint disp, const int pe,
+                                         const MPI_Op op, const MPI_Win& win) {
+  static_assert(MPIDataType<T>::is_predefined,
+                "MPISpace atomic operations require a predefined MPI type");
+#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST
+  MPI_Fetch_and_op(&val, &result, MPIDataType<T>::value(), pe, disp, op, win);
+  MPI_Win_flush_local(pe, win);
+#endif
+}
 
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator--(int) const {
-    T val = T();
-    mpi_type_g(val, offset, pe, win);
-    val--;
-    mpi_type_p(val, offset, pe, win);
-    return val;
+template <class T>
+struct MPIDataHandle;
+
+/** \brief  Backend traits of MPISpace.
+ *
+ *  Elements on other nodes are accessed with one-sided MPI operations,
+ *  elements in the partition of this rank or of a rank sharing a
+ *  shared-memory window directly.  Read-modify-write operations on
+ *  predefined types map to a single MPI_Fetch_and_op or MPI_Accumulate.
+ *  They stay on the MPI path for local elements too since host atomics are
+ *  not atomic with respect to MPI accumulate operations.  Windows stay in
+ *  a passive-target epoch in both RMA modes, so gets and fetching atomics
+ *  complete on return.  Every operation goes through the same window.
+ */
+struct MPIBackend {
+  typedef Kokkos::MPISpace memory_space;
+  typedef Kokkos::HostSpace local_memory_space;
+
+  template <class T>
+  using handle = MPIDataHandle<T>;
+
+  template <class T>
+  struct address {
+    MPI_Win win;
+    // Displacement of the element in the window of rank pe
+    MPI_Aint disp;
+    int pe;
+    // Address of the element if it is directly addressable, NULL otherwise
+    T* ptr;
+    std::atomic<bool>* dirty;
+  };
+
+  template <class T, class Op>
+  struct has_fetch_op
+      : std::integral_constant<bool, MPIDataType<T>::is_predefined> {};
+
+  static MPI_Op op(RemoteSumOp) { return MPI_SUM; }
+  static MPI_Op op(RemoteProdOp) { return MPI_PROD; }
+  static MPI_Op op(RemoteBandOp) { return MPI_BAND; }
+  static MPI_Op op(RemoteBorOp) { return MPI_BOR; }
+  static MPI_Op op(RemoteBxorOp) { return MPI_BXOR; }
+
+  static int num_pes(const memory_space& space) {
+    int n = 0;
+#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST
+    MPI_Comm_size(space.comm, &n);
+#endif
+    return n;
   }
 
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator+=(const_value_type& val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, win);
-    tmp += val;
-    mpi_type_p(tmp, offset, pe, win);
-    return tmp;
+  template <class T>
+  KOKKOS_INLINE_FUNCTION static MPIDataHandle<T> make_handle(T* ptr) {
+    return MPIDataHandle<T>(ptr, MPI_WIN_NULL);
   }
 
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator-=(const_value_type& val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, win);
-    tmp -= val;
-    mpi_type_p(tmp, offset, pe, win);
-    return tmp;
+  template <class T>
+  KOKKOS_INLINE_FUNCTION static MPIDataHandle<T> make_handle(
+      T* ptr, const SharedAllocationRecord<memory_space, void>* record) {
+    return MPIDataHandle<T>(
+        ptr, record->win, record->base_offset + sizeof(SharedAllocationHeader),
+        record->m_space.comm,
+        record->peer_ptrs.empty() ? NULL : record->peer_ptrs.data(),
+        record->dirty);
   }
 
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator*=(const_value_type& val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, win);
-    tmp *= val;
-    mpi_type_p(tmp, offset, pe, win);
-    return tmp;
+  static const int64_t* partition_offsets(
+      const SharedAllocationRecord<memory_space, void>* record) {
+    return record->partition_offsets.empty()
+               ? NULL
+               : record->partition_offsets.data();
   }
 
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator/=(const_value_type& val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, win);
-    tmp /= val;
-    mpi_type_p(tmp, offset, pe, win);
-    return tmp;
+  template <class T>
+  KOKKOS_INLINE_FUNCTION static MPIDataHandle<T> shift(
+      const MPIDataHandle<T>& arg_handle, const size_t offset) {
+    MPIDataHandle<T> handle(arg_handle);
+    handle.ptr += offset;
+    handle.base += offset * sizeof(T);
+    handle.peer_offset += offset;
+    return handle;
   }
 
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator%=(const_value_type& val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, win);
-    tmp %= val;
-    mpi_type_p(tmp, offset, pe, win);
-    return tmp;
+  template <class T>
+  KOKKOS_INLINE_FUNCTION static int my_pe(const MPIDataHandle<T>& handle) {
+    return handle.rank;
   }
 
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator&=(const_value_type& val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, win);
-    tmp &= val;
-    mpi_type_p(tmp, offset, pe, win);
-    return tmp;
+  template <class T>
+  KOKKOS_INLINE_FUNCTION static T* direct(const address<T>& addr) {
+    return addr.ptr;
   }
 
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator^=(const_value_type& val) const {
+  template <class T>
+  KOKKOS_INLINE_FUNCTION static T get(const address<T>& addr) {
     T tmp = T();
-    mpi_type_g(tmp, offset, pe, win);
-    tmp ^= val;
-    mpi_type_p(tmp, offset, pe, win);
+    mpi_mark_dirty(addr.dirty);
+    mpi_complete_puts(addr.pe, addr.win);
+    mpi_type_g<T>(tmp, addr.disp, addr.pe, addr.win);
     return tmp;
   }
 
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator|=(const_value_type& val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, win);
-    tmp |= val;
-    mpi_type_p(tmp, offset, pe, win);
-    return tmp;
+  template <class T>
+  KOKKOS_INLINE_FUNCTION static void put(const address<T>& addr,
+                                         const T& val) {
+    mpi_mark_dirty(addr.dirty);
+    mpi_type_p<T>(val, addr.disp, addr.pe, addr.win);
   }
 
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator<<=(const_value_type& val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, win);
-    tmp <<= val;
-    mpi_type_p(tmp, offset, pe, win);
-    return tmp;
+  template <class T>
+  KOKKOS_INLINE_FUNCTION static void get_async(const address<T>& addr,
+                                               T& val) {
+    mpi_mark_dirty(addr.dirty);
+    mpi_complete_puts(addr.pe, addr.win);
+    mpi_type_get_async<T>(&val, 1, addr.disp, addr.pe, addr.win);
   }
 
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator>>=(const_value_type& val) const {
+  template <class Op, class T>
+  KOKKOS_INLINE_FUNCTION static T fetch_op(const address<T>& addr,
+                                           const T& val) {
     T tmp = T();
-    mpi_type_g(tmp, offset, pe, win);
-    tmp >>= val;
-    mpi_type_p(tmp, offset, pe, win);
+    mpi_mark_dirty(addr.dirty);
+    mpi_complete_puts(addr.pe, addr.win);
+    mpi_type_fop<T>(val, tmp, addr.disp, addr.pe, op(Op()), addr.win);
     return tmp;
   }
 
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator+(const_value_type& val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, win);
-    return tmp + val;
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator-(const_value_type& val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, win);
-    return tmp - val;
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator*(const_value_type& val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, win);
-    return tmp * val;
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator/(const_value_type& val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, win);
-    return tmp / val;
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator%(const_value_type& val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, win);
-    return tmp % val;
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator!() const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, win);
-    return !tmp;
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator&&(const_value_type& val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, win);
-    return tmp && val;
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator||(const_value_type& val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, win);
-    return tmp || val;
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator&(const_value_type& val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, win);
-    return tmp & val;
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator|(const_value_type& val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, win);
-    return tmp | val;
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator^(const_value_type& val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, win);
-    return tmp ^ val;
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator~() const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, win);
-    return ~tmp;
+  template <class Op, class T>
+  KOKKOS_INLINE_FUNCTION static void atomic_op(const address<T>& addr,
+                                               const T& val) {
+    mpi_mark_dirty(addr.dirty);
+    mpi_complete_puts(addr.pe, addr.win);
+    mpi_type_acc<T>(val, addr.disp, addr.pe, op(Op()), addr.win);
   }
 
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator<<(const unsigned int& val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, win);
-    return tmp << val;
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator>>(const unsigned int& val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, win);
-    return tmp >> val;
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  bool operator==(const_value_type& val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, win);
-    return tmp == val;
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  bool operator!=(const_value_type& val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, win);
-    return tmp != val;
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  bool operator>=(const_value_type& val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, win);
-    return tmp >= val;
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  bool operator<=(const_value_type& val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, win);
-    return tmp <= val;
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  bool operator<(const_value_type& val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, win);
-    return tmp < val;
+  template <class T>
+  static void fence(const MPIDataHandle<T>& handle) {
+    mpi_fence_window(handle.win, handle.comm, handle.dirty);
   }
+};
 
-  KOKKOS_INLINE_FUNCTION
-  bool operator>(const_value_type& val) const {
-    T tmp = T();
-    mpi_type_g(tmp, offset, pe, win);
-    return tmp > val;
-  }
+typedef RemoteSpaceSpecializeTag<MPIBackend> MPISpaceSpecializeTag;
 
-  KOKKOS_INLINE_FUNCTION
-  operator const_value_type() const {
-    T tmp;
-    mpi_type_g(tmp, offset, pe, win);
-    return tmp;
-  }
-};
+template <class T>
+using MPIDataElement = RemoteDataElement<MPIBackend, T>;
 
 template <class T>
 struct MPIDataHandle {
   T* ptr;
   MPI_Win win;
-  KOKKOS_INLINE_FUNCTION
-  MPIDataHandle() : ptr(NULL) {}
-  KOKKOS_INLINE_FUNCTION
-  MPIDataHandle(T* ptr_, MPI_Win& win_) : ptr(ptr_), win(win_) {}
+  // Displacement of the first element in the window
+  MPI_Aint base;
+  MPI_Comm comm;
+  int rank;
+  // Partitions of ranks on the same node when backed by a shared-memory
+  // window, indexed by rank, and the offset of a subview into them
+  void* const* peers;
+  size_t peer_offset;
+  // Pending operation flag of win
+  std::atomic<bool>* dirty;
+  KOKKOS_INLINE_FUNCTION
+  MPIDataHandle()
+      : ptr(NULL),
+        base(0),
+        comm(MPI_COMM_NULL),
+        rank(-1),
+        peers(NULL),
+        peer_offset(0),
+        dirty(NULL) {}
+  KOKKOS_INLINE_FUNCTION
+  MPIDataHandle(T* ptr_, const MPI_Win& win_,
+                const MPI_Aint base_      = sizeof(SharedAllocationHeader),
+                const MPI_Comm& comm_     = MPI_COMM_WORLD,
+                void* const* peers_       = NULL,
+                std::atomic<bool>* dirty_ = NULL)
+      : ptr(ptr_),
+        win(win_),
+        base(base_),
+        comm(comm_),
+        rank(-1),
+        peers(peers_),
+        peer_offset(0),
+        dirty(dirty_) {
+#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST
+    MPI_Comm_rank(comm_, &rank);
+#endif
+  }
   template <typename iType>
   KOKKOS_INLINE_FUNCTION MPIDataElement<T> operator()(const int& pe,
                                                       const iType& i) const {
-    MPIDataElement<T> element(win, pe, i);
-    return element;
+    T* local = NULL;
+    if (pe == rank)
+      local = ptr + i;
+    else if (peers && peers[pe])
+      local = static_cast<T*>(peers[pe]) + peer_offset + i;
+    const typename MPIBackend::address<T> addr = {win, base + i * sizeof(T),
+                                                  pe, local, dirty};
+    return MPIDataElement<T>(addr);
   }
 };
 /*
@@ -380,404 +364,185 @@ struct MPIDataHandle<int> {
 };
 */
 
-template <class Traits>
-struct ViewDataHandle<
-    Traits,
-    typename std::enable_if<std::is_same<typename Traits::specialize,
-                                         MPISpaceSpecializeTag>::value>::type> {
-  typedef typename Traits::value_type value_type;
-  typedef MPIDataHandle<value_type> handle_type;
-  typedef MPIDataElement<value_type> return_type;
-  typedef Kokkos::Impl::SharedAllocationTracker track_type;
-
-  KOKKOS_INLINE_FUNCTION
-  static handle_type assign(value_type* arg_data_ptr,
-                            track_type const& arg_tracker) {
-    return handle_type(
-        arg_data_ptr, arg_tracker.template get_record<Kokkos::MPISpace>()->win);
-  }
-  /*
-    KOKKOS_INLINE_FUNCTION
-    static handle_type assign( handle_type const arg_data_ptr
-                             , size_t offset )
-    {
-      return handle_type( arg_data_ptr + offset );
-    }*/
-};
-
 }  // namespace Impl
 
 template <class... Prop>
-struct ViewTraits<void, MPISpace, Prop...> {
-  // Specify Space, memory traits should be the only subsequent argument.
-
-  static_assert(
-      std::is_same<typename ViewTraits<void, Prop...>::execution_space,
-                   void>::value &&
-          std::is_same<typename ViewTraits<void, Prop...>::memory_space,
-                       void>::value &&
-          std::is_same<typename ViewTraits<void, Prop...>::HostMirrorSpace,
-                       void>::value &&
-          std::is_same<typename ViewTraits<void, Prop...>::array_layout,
-                       void>::value,
-      "Only one View Execution or Memory Space template argument");
-
-  typedef typename MPISpace::execution_space execution_space;
-  typedef typename MPISpace::memory_space memory_space;
-  typedef typename Kokkos::Impl::HostMirror<MPISpace>::Space HostMirrorSpace;
-  typedef typename execution_space::array_layout array_layout;
-  typedef typename ViewTraits<void, Prop...>::memory_traits memory_traits;
-  typedef typename Impl::MPISpaceSpecializeTag specialize;
-};
+struct ViewTraits<void, MPISpace, Prop...>
+    : Impl::RemoteSpaceViewTraits<MPISpace, Impl::MPISpaceSpecializeTag,
+                                  Prop...> {};
 
 namespace Impl {
 
-template <class Traits>
-class ViewMapping<Traits, MPISpaceSpecializeTag> {
- private:
-  template <class, class...>
-  friend class ViewMapping;
-  template <class, class...>
-  friend class Kokkos::View;
-
-  typedef ViewOffset<typename Traits::dimension, typename Traits::array_layout,
-                     void>
-      offset_type;
-
-  typedef typename ViewDataHandle<Traits>::handle_type handle_type;
-
-  handle_type m_handle;
-  offset_type m_offset;
-  int m_num_pes;
-
-  KOKKOS_INLINE_FUNCTION
-  ViewMapping(const handle_type& arg_handle, const offset_type& arg_offset)
-      : m_handle(arg_handle), m_offset(arg_offset) {}
-
- public:
-  typedef void printable_label_typedef;
-  enum { is_managed = Traits::is_managed };
-
-  //----------------------------------------
-  // Domain dimensions
-
-  enum { Rank = Traits::dimension::rank };
-
-  template <typename iType>
-  KOKKOS_INLINE_FUNCTION constexpr size_t extent(const iType& r) const {
-    return m_offset.m_dim.extent(r);
-  }
-
-  KOKKOS_INLINE_FUNCTION constexpr typename Traits::array_layout layout()
-      const {
-    return m_offset.layout();
-  }
-
-  KOKKOS_INLINE_FUNCTION constexpr size_t dimension_0() const {
-    return m_num_pes;
-  }
-  KOKKOS_INLINE_FUNCTION constexpr size_t dimension_1() const {
-    return m_offset.dimension_1();
-  }
-  KOKKOS_INLINE_FUNCTION constexpr size_t dimension_2() const {
-    return m_offset.dimension_2();
-  }
-  KOKKOS_INLINE_FUNCTION constexpr size_t dimension_3() const {
-    return m_offset.dimension_3();
-  }
-  KOKKOS_INLINE_FUNCTION constexpr size_t dimension_4() const {
-    return m_offset.dimension_4();
-  }
-  KOKKOS_INLINE_FUNCTION constexpr size_t dimension_5() const {
-    return m_offset.dimension_5();
-  }
-  KOKKOS_INLINE_FUNCTION constexpr size_t dimension_6() const {
-    return m_offset.dimension_6();
-  }
-  KOKKOS_INLINE_FUNCTION constexpr size_t dimension_7() const {
-    return m_offset.dimension_7();
-  }
-
-  // Is a regular layout with uniform striding for each index.
-  using is_regular = typename offset_type::is_regular;
-
-  KOKKOS_INLINE_FUNCTION constexpr size_t stride_0() const {
-    return m_offset.stride_0();
-  }
-  KOKKOS_INLINE_FUNCTION constexpr size_t stride_1() const {
-    return m_offset.stride_1();
-  }
-  KOKKOS_INLINE_FUNCTION constexpr size_t stride_2() const {
-    return m_offset.stride_2();
-  }
-  KOKKOS_INLINE_FUNCTION constexpr size_t stride_3() const {
-    return m_offset.stride_3();
-  }
-  KOKKOS_INLINE_FUNCTION constexpr size_t stride_4() const {
-    return m_offset.stride_4();
-  }
-  KOKKOS_INLINE_FUNCTION constexpr size_t stride_5() const {
-    return m_offset.stride_5();
-  }
-  KOKKOS_INLINE_FUNCTION constexpr size_t stride_6() const {
-    return m_offset.stride_6();
-  }
-  KOKKOS_INLINE_FUNCTION constexpr size_t stride_7() const {
-    return m_offset.stride_7();
-  }
-
-  template <typename iType>
-  KOKKOS_INLINE_FUNCTION void stride(iType* const s) const {
-    m_offset.stride(s);
-  }
-
-  //----------------------------------------
-  // Range span
-
-  /** \brief  Span of the mapped range */
-  KOKKOS_INLINE_FUNCTION constexpr size_t span() const {
-    return m_offset.span();
-  }
-
-  /** \brief  Is the mapped range span contiguous */
-  KOKKOS_INLINE_FUNCTION constexpr bool span_is_contiguous() const {
-    return m_offset.span_is_contiguous();
-  }
-
-  typedef typename ViewDataHandle<Traits>::return_type reference_type;
-  typedef typename Traits::value_type* pointer_type;
-
-  /** \brief  Query raw pointer to memory */
-  KOKKOS_INLINE_FUNCTION constexpr pointer_type data() const {
-    return m_handle.ptr;
-  }
-
-  //----------------------------------------
-  // The View class performs all rank and bounds checking before
-  // calling these element reference methods.
-
-  KOKKOS_FORCEINLINE_FUNCTION
-  reference_type reference() const { return m_handle[0]; }
-
-  template <typename I0>
-  KOKKOS_FORCEINLINE_FUNCTION
-      typename std::enable_if<std::is_integral<I0>::value &&
-                                  !std::is_same<typename Traits::array_layout,
-                                                Kokkos::LayoutStride>::value,
-                              reference_type>::type
-      reference(const I0& i0) const {
-    return m_handle(i0, 0);
-  }
-
-  template <typename I0>
-  KOKKOS_FORCEINLINE_FUNCTION
-      typename std::enable_if<std::is_integral<I0>::value &&
-                                  std::is_same<typename Traits::array_layout,
-                                               Kokkos::LayoutStride>::value,
-                              reference_type>::type
-      reference(const I0& i0) const {
-    return m_handle(i0, 0);
-  }
-
-  template <typename I0, typename I1>
-  KOKKOS_FORCEINLINE_FUNCTION const reference_type
-  reference(const I0& i0, const I1& i1) const {
-    const reference_type element = m_handle(i0, m_offset(0, i1));
-    return element;
-  }
-
-  template <typename I0, typename I1, typename I2>
-  KOKKOS_FORCEINLINE_FUNCTION reference_type reference(const I0& i0,
-                                                       const I1& i1,
-                                                       const I2& i2) const {
-    return m_handle(i0, m_offset(0, i1, i2));
-  }
-
-  template <typename I0, typename I1, typename I2, typename I3>
-  KOKKOS_FORCEINLINE_FUNCTION reference_type
-  reference(const I0& i0, const I1& i1, const I2& i2, const I3& i3) const {
-    return m_handle(i0, m_offset(0, i1, i2, i3));
-  }
-
-  template <typename I0, typename I1, typename I2, typename I3, typename I4>
-  KOKKOS_FORCEINLINE_FUNCTION reference_type reference(const I0& i0,
-                                                       const I1& i1,
-                                                       const I2& i2,
-                                                       const I3& i3,
-                                                       const I4& i4) const {
-    return m_handle(i0, m_offset(0, i1, i2, i3, i4));
-  }
-
-  template <typename I0, typename I1, typename I2, typename I3, typename I4,
-            typename I5>
-  KOKKOS_FORCEINLINE_FUNCTION reference_type
-  reference(const I0& i0, const I1& i1, const I2& i2, const I3& i3,
-            const I4& i4, const I5& i5) const {
-    return m_handle(i0, m_offset(0, i1, i2, i3, i4, i5));
-  }
-
-  template <typename I0, typename I1, typename I2, typename I3, typename I4,
-            typename I5, typename I6>
-  KOKKOS_FORCEINLINE_FUNCTION reference_type
-  reference(const I0& i0, const I1& i1, const I2& i2, const I3& i3,
-            const I4& i4, const I5& i5, const I6& i6) const {
-    return m_handle(i0, m_offset(0, i1, i2, i3, i4, i5, i6));
-  }
-
-  template <typename I0, typename I1, typename I2, typename I3, typename I4,
-            typename I5, typename I6, typename I7>
-  KOKKOS_FORCEINLINE_FUNCTION reference_type
-  reference(const I0& i0, const I1& i1, const I2& i2, const I3& i3,
-            const I4& i4, const I5& i5, const I6& i6, const I7& i7) const {
-    return m_handle(i0, m_offset(0, i1, i2, i3, i4, i5, i6, i7));
-  }
-
-  //----------------------------------------
-
- private:
-  enum { MemorySpanMask = 8 - 1 /* Force alignment on 8 byte boundary */ };
-  enum { MemorySpanSize = sizeof(typename Traits::value_type) };
-
- public:
-  /** \brief  Span, in bytes, of the referenced memory */
-  KOKKOS_INLINE_FUNCTION constexpr size_t memory_span() const {
-    return (m_offset.span() * sizeof(typename Traits::value_type) +
-            MemorySpanMask) &
-           ~size_t(MemorySpanMask);
-  }
-
-  //----------------------------------------
-
-  KOKKOS_INLINE_FUNCTION ~ViewMapping() {}
-  KOKKOS_INLINE_FUNCTION ViewMapping() : m_handle(), m_offset(), m_num_pes(0) {}
-  KOKKOS_INLINE_FUNCTION ViewMapping(const ViewMapping& rhs)
-      : m_handle(rhs.m_handle),
-        m_offset(rhs.m_offset),
-        m_num_pes(rhs.m_num_pes) {}
-  KOKKOS_INLINE_FUNCTION ViewMapping& operator=(const ViewMapping& rhs) {
-    m_handle  = rhs.m_handle;
-    m_offset  = rhs.m_offset;
-    m_num_pes = rhs.m_num_pes;
-    return *this;
-  }
-
-  KOKKOS_INLINE_FUNCTION ViewMapping(ViewMapping&& rhs)
-      : m_handle(rhs.m_handle),
-        m_offset(rhs.m_offset),
-        m_num_pes(rhs.m_num_pes) {}
-  KOKKOS_INLINE_FUNCTION ViewMapping& operator=(ViewMapping&& rhs) {
-    m_handle  = rhs.m_handle;
-    m_offset  = rhs.m_offset;
-    m_num_pes = rhs.m_num_pes;
-    return *this;
-  }
-
-  //----------------------------------------
-
-  /**\brief  Span, in bytes, of the required memory */
-  KOKKOS_INLINE_FUNCTION
-  static constexpr size_t memory_span(
-      typename Traits::array_layout const& arg_layout) {
-    typedef std::integral_constant<unsigned, 0> padding;
-    return (offset_type(padding(), arg_layout).span() * MemorySpanSize +
-            MemorySpanMask) &
-           ~size_t(MemorySpanMask);
+/* Contiguous ranges are moved with one MPI_Put or MPI_Get per INT_MAX
+ * elements, or copied directly if the partition is addressable.  In
+ * active-target mode the transfer completes at the next fence(); in
+ * passive-target mode it is locally complete on return.  Signals are flag
+ * words set with MPI_Accumulate after the data is flushed and polled with
+ * MPI_Fetch_and_op, which needs passive-target epochs. */
+template <>
+struct RemoteBlockTransfer<MPISpaceSpecializeTag> {
+  template <class T>
+  static T* direct(const MPIDataHandle<T>& handle, const int pe) {
+    if (pe == handle.rank) return handle.ptr;
+    if (handle.peers && handle.peers[pe])
+      return static_cast<T*>(handle.peers[pe]) + handle.peer_offset;
+    return NULL;
+  }
+
+  template <class T, class RemoteView>
+  static void get(T* dst, const RemoteView& src, const int pe,
+                  const size_t offset, const size_t count) {
+    const MPIDataHandle<T>& handle = src.impl_map().handle();
+    if (T* ptr = direct(handle, pe)) {
+      memcpy(dst, ptr + offset, count * sizeof(T));
+      return;
+    }
+    mpi_mark_dirty(handle.dirty);
+    const MPI_Datatype type = MPIDataType<T>::value();
+    for (size_t i = 0; i < count; i += INT_MAX) {
+      const int n = std::min(count - i, size_t(INT_MAX));
+      MPI_Get(dst + i, n, type, pe, handle.base + (offset + i) * sizeof(T), n,
+              type, handle.win);
+    }
+    if (MPISpace::rma_mode == MPISpace::PassiveTarget)
+      MPI_Win_flush_local(pe, handle.win);
   }
 
-  /**\brief  Wrap a span of memory */
-  template <class... P>
-  KOKKOS_INLINE_FUNCTION ViewMapping(
-      Kokkos::Impl::ViewCtorProp<P...> const& arg_prop,
-      typename Traits::array_layout const& arg_layout)
-      : m_handle(
-            ((Kokkos::Impl::ViewCtorProp<void, pointer_type> const&)arg_prop)
-                .value) {
-    typedef typename Traits::value_type value_type;
-    typedef std::integral_constant<
-        unsigned, Kokkos::Impl::ViewCtorProp<P...>::allow_padding
-                      ? sizeof(value_type)
-                      : 0>
-        padding;
-
-    typename Traits::array_layout layout;
-    for (int i = 0; i < Traits::rank; i++)
-      layout.dimension[i] = arg_layout.dimension[i];
-    layout.dimension[0] = 1;
-    m_offset            = offset_type(padding(), layout);
-    MPI_Comm_size(MPI_COMM_WORLD, &m_num_pes);
+  template <class T, class RemoteView>
+  static void put(const T* src, const RemoteView& dst, const int pe,
+                  const size_t offset, const size_t count) {
+    const MPIDataHandle<T>& handle = dst.impl_map().handle();
+    if (T* ptr = direct(handle, pe)) {
+      memcpy(ptr + offset, src, count * sizeof(T));
+      return;
+    }
+    mpi_mark_dirty(handle.dirty);
+    const MPI_Datatype type = MPIDataType<T>::value();
+    for (size_t i = 0; i < count; i += INT_MAX) {
+      const int n = std::min(count - i, size_t(INT_MAX));
+      MPI_Put(src + i, n, type, pe, handle.base + (offset + i) * sizeof(T), n,
+              type, handle.win);
+    }
+    if (MPISpace::rma_mode == MPISpace::PassiveTarget)
+      MPI_Win_flush_local(pe, handle.win);
   }
 
-  /**\brief  Assign data */
-  KOKKOS_INLINE_FUNCTION
-  void assign_data(pointer_type arg_ptr) { m_handle = handle_type(arg_ptr); }
-
-  //----------------------------------------
-  /*  Allocate and construct mapped array.
-   *  Allocate via shared allocation record and
-   *  return that record for allocation tracking.
-   */
-  template <class... P>
-  Kokkos::Impl::SharedAllocationRecord<>* allocate_shared(
-      Kokkos::Impl::ViewCtorProp<P...> const& arg_prop,
-      typename Traits::array_layout const& arg_layout) {
-    typedef Kokkos::Impl::ViewCtorProp<P...> alloc_prop;
-
-    typedef typename alloc_prop::execution_space execution_space;
-    typedef typename Traits::memory_space memory_space;
-    typedef typename Traits::value_type value_type;
-    typedef ViewValueFunctor<execution_space, value_type> functor_type;
-    typedef Kokkos::Impl::SharedAllocationRecord<memory_space, functor_type>
-        record_type;
-
-    // Query the mapping for byte-size of allocation.
-    // If padding is allowed then pass in sizeof value type
-    // for padding computation.
-    typedef std::integral_constant<
-        unsigned, alloc_prop::allow_padding ? sizeof(value_type) : 0>
-        padding;
-
-    typename Traits::array_layout layout;
-    for (int i = 0; i < Traits::rank; i++)
-      layout.dimension[i] = arg_layout.dimension[i];
-    layout.dimension[0] = 1;
-    m_offset            = offset_type(padding(), layout);
-    MPI_Comm_size(MPI_COMM_WORLD, &m_num_pes);
-    const size_t alloc_size =
-        (m_offset.span() * MemorySpanSize + MemorySpanMask) &
-        ~size_t(MemorySpanMask);
-
-    // Create shared memory tracking record with allocate memory from the memory
-    // space
-    record_type* const record = record_type::allocate(
-        ((Kokkos::Impl::ViewCtorProp<void, memory_space> const&)arg_prop).value,
-        ((Kokkos::Impl::ViewCtorProp<void, std::string> const&)arg_prop).value,
-        alloc_size);
-
-#ifdef KOKKOS_ENABLE_DEPRECATED_CODE
-    if (alloc_size) {
-#endif
-      m_handle = handle_type(reinterpret_cast<pointer_type>(record->data()),
-                             record->win);
-#ifdef KOKKOS_ENABLE_DEPRECATED_CODE
+  template <class T, class RemoteView>
+  static void get_async(T* dst, const RemoteView& src, const int pe,
+                        const size_t offset, const size_t count) {
+    const MPIDataHandle<T>& handle = src.impl_map().handle();
+    if (T* ptr = direct(handle, pe)) {
+      memcpy(dst, ptr + offset, count * sizeof(T));
+      return;
     }
-#endif
-
-    //  Only initialize if the allocation is non-zero.
-    //  May be zero if one of the dimensions is zero.
-    if (alloc_size && alloc_prop::initialize) {
-      // Assume destruction is only required when construction is requested.
-      // The ViewValueFunctor has both value construction and destruction
-      // operators.
-      /*record->m_destroy = functor_type( (
-         (Kokkos::Impl::ViewCtorProp<void,execution_space> const &)
-         arg_prop).value , (value_type *) m_handle , m_offset.span()
-                                      );*/
-
-      // Construct values
-      record->m_destroy.construct_shared_allocation();
+    mpi_mark_dirty(handle.dirty);
+    mpi_type_get_async<T>(dst, count, handle.base + offset * sizeof(T), pe,
+                          handle.win);
+  }
+
+  template <class T, class RemoteView, class SignalView>
+  static void put_signal(const T* src, const RemoteView& dst, const int pe,
+                         const size_t offset, const size_t count,
+                         const SignalView& signal, const size_t idx,
+                         const uint64_t value) {
+    if (MPISpace::rma_mode != MPISpace::PassiveTarget)
+      Kokkos::abort("remote_put_signal requires MPISpace::PassiveTarget.");
+    const MPIDataHandle<T>& handle       = dst.impl_map().handle();
+    const MPIDataHandle<uint64_t>& flags = signal.impl_map().handle();
+    put(src, dst, pe, offset, count);
+    // Deliver the data, stored directly or put, before the signal
+    if (!direct(handle, pe)) MPI_Win_flush(pe, handle.win);
+    std::atomic_thread_fence(std::memory_order_release);
+    MPI_Accumulate(&value, 1, MPI_UINT64_T, pe,
+                   flags.base + idx * sizeof(uint64_t), 1, MPI_UINT64_T,
+                   MPI_REPLACE, flags.win);
+    MPI_Win_flush(pe, flags.win);
+  }
+
+  static bool compare(const uint64_t a, const int cmp, const uint64_t b) {
+    switch (cmp) {
+      case Experimental::RemoteCmpEq: return a == b;
+      case Experimental::RemoteCmpNe: return a != b;
+      case Experimental::RemoteCmpGt: return a > b;
+      case Experimental::RemoteCmpGe: return a >= b;
+      case Experimental::RemoteCmpLt: return a < b;
+      case Experimental::RemoteCmpLe: return a <= b;
     }
-
-    return record;
+    Kokkos::abort("Unknown remote_wait_until comparison.");
+    return false;
+  }
+
+  // Polling through MPI also drives progress of the incoming accumulate
+  template <class SignalView>
+  static void wait_until(const SignalView& signal, const size_t idx,
+                         const int cmp, const uint64_t value) {
+    if (MPISpace::rma_mode != MPISpace::PassiveTarget)
+      Kokkos::abort("remote_wait_until requires MPISpace::PassiveTarget.");
+    const MPIDataHandle<uint64_t>& flags = signal.impl_map().handle();
+    const MPI_Aint disp                  = flags.base + idx * sizeof(uint64_t);
+    uint64_t current;
+    do {
+      MPI_Fetch_and_op(NULL, &current, MPI_UINT64_T, flags.rank, disp,
+                       MPI_NO_OP, flags.win);
+      MPI_Win_flush(flags.rank, flags.win);
+    } while (!compare(current, cmp, value));
+    std::atomic_thread_fence(std::memory_order_acquire);
+  }
+
+  // A strided block is described by one nested hvector target datatype
+  template <class T>
+  static void strided(T* local, const MPIDataHandle<T>& handle, const int pe,
+                      const int rank, const size_t* extents,
+                      const size_t* strides, const bool put) {
+    if (T* ptr = direct(handle, pe)) {
+      remote_strided_runs(rank, extents, strides,
+                          [&](size_t l, size_t r, size_t n, size_t stride) {
+                            for (size_t j = 0; j < n; j++) {
+                              if (put)
+                                ptr[r + j * stride] = local[l + j];
+                              else
+                                local[l + j] = ptr[r + j * stride];
+                            }
+                          });
+      return;
+    }
+    mpi_mark_dirty(handle.dirty);
+    const MPI_Datatype type = MPIDataType<T>::value();
+    MPI_Datatype target     = type;
+    size_t count            = 1;
+    for (int r = rank - 1; r >= 0; r--) {
+      MPI_Datatype nested;
+      MPI_Type_create_hvector(int(extents[r]), 1, strides[r] * sizeof(T),
+                              target, &nested);
+      if (target != type) MPI_Type_free(&target);
+      target = nested;
+      count *= extents[r];
+    }
+    if (count > size_t(INT_MAX))
+      Kokkos::abort("Strided remote transfers are limited to INT_MAX elements");
+    MPI_Type_commit(&target);
+    if (put)
+      MPI_Put(local, int(count), type, pe, handle.base, 1, target, handle.win);
+    else
+      MPI_Get(local, int(count), type, pe, handle.base, 1, target, handle.win);
+    MPI_Type_free(&target);
+    if (MPISpace::rma_mode == MPISpace::PassiveTarget)
+      MPI_Win_flush_local(pe, handle.win);
+  }
+
+  template <class T, class RemoteView>
+  static void get_strided(T* dst, const RemoteView& src, const int pe,
+                          const int rank, const size_t* extents,
+                          const size_t* strides) {
+    strided(dst, src.impl_map().handle(), pe, rank, extents, strides, false);
+  }
+
+  template <class T, class RemoteView>
+  static void put_strided(const T* src, const RemoteView& dst, const int pe,
+                          const int rank, const size_t* extents,
+                          const size_t* strides) {
+    strided(const_cast<T*>(src), dst.impl_map().handle(), pe, rank, extents,
+            strides, true);
   }
 };
 
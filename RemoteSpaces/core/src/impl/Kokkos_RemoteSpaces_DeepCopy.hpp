@@ -0,0 +1,123 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  H. Carter Edwards (hcedwar@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOS_REMOTESPACES_DEEPCOPY_HPP
+#define KOKKOS_REMOTESPACES_DEEPCOPY_HPP
+
+#include <cstdint>
+#include <type_traits>
+
+//----------------------------------------------------------------------------
+/** \brief  DeepCopy shared by the host-accessible remote spaces.
+ *
+ *  Used for copies within a remote space and between it and HostSpace,
+ *  see KOKKOS_IMPL_REMOTE_SPACE_HOST_DEEP_COPY.
+ */
+//----------------------------------------------------------------------------
+
+namespace Kokkos {
+namespace Impl {
+
+template <class T>
+struct RemoteSpaceHostCopyFunctor {
+  T* dst;
+  const T* src;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_t i) const { dst[i] = src[i]; }
+};
+
+template <class ExecutionSpace>
+struct RemoteSpaceHostDeepCopy {
+  enum {
+    host_accessible = Kokkos::SpaceAccessibility<ExecutionSpace,
+                                                 Kokkos::HostSpace>::accessible
+  };
+
+  RemoteSpaceHostDeepCopy(void* dst, const void* src, size_t n) {
+    hostspace_parallel_deepcopy(dst, src, n);
+  }
+
+  RemoteSpaceHostDeepCopy(const ExecutionSpace& exec, void* dst,
+                          const void* src, size_t n) {
+    copy(exec, dst, src, n, std::integral_constant<bool, host_accessible>());
+  }
+
+ private:
+  // A kernel on exec is ordered with the other work on it like any other
+  static void copy(const ExecutionSpace& exec, void* dst, const void* src,
+                   size_t n, std::true_type) {
+    const uintptr_t bits = reinterpret_cast<uintptr_t>(dst) |
+                           reinterpret_cast<uintptr_t>(src) | n;
+    if (bits % sizeof(int64_t) == 0)
+      parallel_copy(exec, static_cast<int64_t*>(dst),
+                    static_cast<const int64_t*>(src), n / sizeof(int64_t));
+    else
+      parallel_copy(exec, static_cast<char*>(dst),
+                    static_cast<const char*>(src), n);
+  }
+
+  // exec cannot access host memory.  Its pending work may still produce
+  // src, the copy itself is complete on return.
+  static void copy(const ExecutionSpace& exec, void* dst, const void* src,
+                   size_t n, std::false_type) {
+    exec.fence();
+    hostspace_parallel_deepcopy(dst, src, n);
+  }
+
+  template <class T>
+  static void parallel_copy(const ExecutionSpace& exec, T* dst, const T* src,
+                            const size_t count) {
+    const RemoteSpaceHostCopyFunctor<T> functor = {dst, src};
+    Kokkos::parallel_for(
+        "Kokkos::Impl::RemoteSpaceHostDeepCopy",
+        Kokkos::RangePolicy<ExecutionSpace, Kokkos::IndexType<size_t>>(
+            exec, 0, count),
+        functor);
+  }
+};
+
+}  // namespace Impl
+}  // namespace Kokkos
+
+#endif  // KOKKOS_REMOTESPACES_DEEPCOPY_HPP
@@ -0,0 +1,519 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  H. Carter Edwards (hcedwar@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOS_REMOTESPACES_SUBVIEW_HPP
+#define KOKKOS_REMOTESPACES_SUBVIEW_HPP
+
+#include <type_traits>
+
+//----------------------------------------------------------------------------
+/** \brief  Subview mapping shared by the remote spaces.
+ *
+ *  The leading index of a remote view is the rank owning a partition.  A
+ *  subview that takes Kokkos::ALL for that index keeps it.  A subview that
+ *  passes an integer is restricted to that rank.  Its indices then address
+ *  the partition only, and it can be copied to or from a local view in one
+ *  transfer with deep_copy.  deep_copy of a view indexed by rank copies the
+ *  partition of the calling rank.
+ */
+namespace Kokkos {
+namespace Impl {
+
+/* Specialization tags of remote spaces supporting subviews */
+template <class Specialize>
+struct is_remote_view_specialize : std::false_type {};
+
+template <class T, unsigned Rank>
+struct RemoteSubviewDataType {
+  typedef typename RemoteSubviewDataType<T, Rank - 1>::type* type;
+};
+
+template <class T>
+struct RemoteSubviewDataType<T, 0> {
+  typedef T type;
+};
+
+typedef typename std::decay<decltype(Kokkos::ALL)>::type remote_all_type;
+
+template <class... Args>
+struct RemoteSubviewIsAll : std::true_type {};
+
+template <class Arg, class... Args>
+struct RemoteSubviewIsAll<Arg, Args...>
+    : std::integral_constant<
+          bool, std::is_same<typename std::decay<Arg>::type,
+                             remote_all_type>::value &&
+                    RemoteSubviewIsAll<Args...>::value> {};
+
+template <class SrcTraits, class... Args>
+class ViewMapping<
+    typename std::enable_if<is_remote_view_specialize<
+        typename SrcTraits::specialize>::value>::type,
+    SrcTraits, Args...> {
+ private:
+  static_assert(SrcTraits::rank == sizeof...(Args),
+                "Subview mapping requires one argument for each dimension "
+                "of source View");
+
+  enum {
+    R0 = bool(is_integral_extent<0, Args...>::value),
+    R1 = bool(is_integral_extent<1, Args...>::value),
+    R2 = bool(is_integral_extent<2, Args...>::value),
+    R3 = bool(is_integral_extent<3, Args...>::value),
+    R4 = bool(is_integral_extent<4, Args...>::value),
+    R5 = bool(is_integral_extent<5, Args...>::value),
+    R6 = bool(is_integral_extent<6, Args...>::value),
+    R7 = bool(is_integral_extent<7, Args...>::value)
+  };
+
+  enum {
+    rank = unsigned(R0) + unsigned(R1) + unsigned(R2) + unsigned(R3) +
+           unsigned(R4) + unsigned(R5) + unsigned(R6) + unsigned(R7)
+  };
+
+  // Only a subview taking every index whole keeps the source layout
+  typedef std::integral_constant<bool, RemoteSubviewIsAll<Args...>::value>
+      is_identity;
+
+  typedef typename std::conditional<is_identity::value,
+                                    typename SrcTraits::array_layout,
+                                    Kokkos::LayoutStride>::type array_layout;
+
+  typedef typename RemoteSubviewDataType<typename SrcTraits::value_type,
+                                         rank>::type data_type;
+
+ public:
+  typedef Kokkos::ViewTraits<data_type, array_layout,
+                             typename SrcTraits::memory_space,
+                             typename SrcTraits::memory_traits>
+      traits_type;
+
+  typedef Kokkos::View<data_type, array_layout,
+                       typename SrcTraits::memory_space,
+                       typename SrcTraits::memory_traits>
+      type;
+
+  template <class MemoryTraits>
+  struct apply {
+    static_assert(Kokkos::Impl::is_memory_traits<MemoryTraits>::value, "");
+
+    typedef Kokkos::ViewTraits<data_type, array_layout,
+                               typename SrcTraits::memory_space, MemoryTraits>
+        traits_type;
+
+    typedef Kokkos::View<data_type, array_layout,
+                         typename SrcTraits::memory_space, MemoryTraits>
+        type;
+  };
+
+ private:
+  // The leading extent of an unrestricted remote view's offset is one, so
+  // the rank index is replaced by an index into that extent
+  template <class PeArg>
+  KOKKOS_INLINE_FUNCTION static typename std::enable_if<
+      std::is_integral<PeArg>::value, int>::type
+  partition_index(const PeArg&) {
+    return 0;
+  }
+
+  template <class PeArg>
+  KOKKOS_INLINE_FUNCTION static typename std::enable_if<
+      !std::is_integral<PeArg>::value, remote_all_type>::type
+  partition_index(const PeArg&) {
+    static_assert(std::is_same<PeArg, remote_all_type>::value,
+                  "The leading index of a remote subview must be an integer "
+                  "or Kokkos::ALL");
+    return Kokkos::ALL;
+  }
+
+  template <class PeArg>
+  KOKKOS_INLINE_FUNCTION static typename std::enable_if<
+      std::is_integral<PeArg>::value, int>::type
+  restricted_pe(const PeArg& pe) {
+    return int(pe);
+  }
+
+  template <class PeArg>
+  KOKKOS_INLINE_FUNCTION static typename std::enable_if<
+      !std::is_integral<PeArg>::value, int>::type
+  restricted_pe(const PeArg&) {
+    return -1;
+  }
+
+  typedef ViewMapping<SrcTraits, typename SrcTraits::specialize> src_mapping;
+  typedef typename src_mapping::offset_type::dimension_type src_dimension;
+
+  // Dimension 1 of an asymmetric view spans the largest partition, a
+  // subview restricted to one rank spans the partition of that rank
+  KOKKOS_INLINE_FUNCTION static src_dimension partition_dimension(
+      const src_mapping& src, const int pe) {
+    const src_dimension& dim = src.m_offset.m_dim;
+    if (pe < 0 || !src.m_partition) return dim;
+    return src_dimension(dim.extent(0), src.partition_extent(pe),
+                         dim.extent(2), dim.extent(3), dim.extent(4),
+                         dim.extent(5), dim.extent(6), dim.extent(7));
+  }
+
+  template <class DstOffset, class SrcOffset, class Extents>
+  KOKKOS_INLINE_FUNCTION static DstOffset make_offset(const SrcOffset& src,
+                                                      const Extents&,
+                                                      std::true_type) {
+    return DstOffset(src);
+  }
+
+  template <class DstOffset, class SrcOffset, class Extents>
+  KOKKOS_INLINE_FUNCTION static DstOffset make_offset(const SrcOffset& src,
+                                                      const Extents& extents,
+                                                      std::false_type) {
+    return DstOffset(src, extents);
+  }
+
+  template <class DstTraits, class Extents>
+  KOKKOS_INLINE_FUNCTION static void assign_extents(
+      ViewMapping<DstTraits, typename DstTraits::specialize>& dst,
+      ViewMapping<SrcTraits, typename SrcTraits::specialize> const& src,
+      const Extents& extents) {
+    typedef typename ViewMapping<DstTraits, typename DstTraits::specialize>::
+        offset_type dst_offset_type;
+
+    dst.m_offset = make_offset<dst_offset_type>(src.m_offset, extents,
+                                                is_identity());
+    dst.m_handle = ViewDataHandle<DstTraits>::assign(
+        src.m_handle,
+        src.m_offset(extents.domain_offset(0), extents.domain_offset(1),
+                     extents.domain_offset(2), extents.domain_offset(3),
+                     extents.domain_offset(4), extents.domain_offset(5),
+                     extents.domain_offset(6), extents.domain_offset(7)));
+    dst.m_num_pes = src.m_num_pes;
+  }
+
+ public:
+  template <class DstTraits, class PeArg, class... SubArgs>
+  KOKKOS_INLINE_FUNCTION static void assign(
+      ViewMapping<DstTraits, typename DstTraits::specialize>& dst,
+      ViewMapping<SrcTraits, typename SrcTraits::specialize> const& src,
+      const PeArg& pe, SubArgs... args) {
+    if (src.m_pe < 0) {
+      const int dst_pe = restricted_pe(pe);
+      const SubviewExtents<SrcTraits::rank, rank> extents(
+          partition_dimension(src, dst_pe), partition_index(pe), args...);
+      assign_extents(dst, src, extents);
+      dst.m_pe = dst_pe;
+      // The partition bounds still apply while dimension 1 of the subview
+      // starts at the first index of every partition
+      if (dst_pe < 0 && extents.range_index(1) == 1 &&
+          extents.domain_offset(1) == 0)
+        dst.m_partition = src.m_partition;
+    } else {
+      // Already restricted to a rank, all indices address the partition
+      const SubviewExtents<SrcTraits::rank, rank> extents(src.m_offset.m_dim,
+                                                          pe, args...);
+      assign_extents(dst, src, extents);
+      dst.m_pe = src.m_pe;
+    }
+  }
+};
+
+/* Assignment between remote views of the same space and value type, as
+ * used when constructing a subview of the derived type */
+template <class DstTraits, class SrcTraits>
+struct RemoteViewMappingAssign {
+  enum {
+    is_assignable =
+        std::is_same<typename DstTraits::value_type,
+                     typename SrcTraits::value_type>::value &&
+        std::is_same<typename DstTraits::memory_space,
+                     typename SrcTraits::memory_space>::value &&
+        unsigned(DstTraits::rank) == unsigned(SrcTraits::rank) &&
+        (std::is_same<typename DstTraits::array_layout,
+                      typename SrcTraits::array_layout>::value ||
+         std::is_same<typename DstTraits::array_layout,
+                      Kokkos::LayoutStride>::value)
+  };
+
+  typedef Kokkos::Impl::SharedAllocationTracker TrackType;
+  typedef ViewMapping<DstTraits, typename DstTraits::specialize> DstType;
+  typedef ViewMapping<SrcTraits, typename SrcTraits::specialize> SrcType;
+
+  KOKKOS_INLINE_FUNCTION
+  static void assign(DstType& dst, const SrcType& src, const TrackType&) {
+    static_assert(is_assignable,
+                  "Incompatible remote view mapping assignment");
+    typedef typename DstType::offset_type dst_offset_type;
+    dst.m_offset    = dst_offset_type(src.m_offset);
+    dst.m_handle    = src.m_handle;
+    dst.m_num_pes   = src.m_num_pes;
+    dst.m_pe        = src.m_pe;
+    dst.m_partition = src.m_partition;
+  }
+};
+
+/* Calls f(local_index, remote_index, count, remote_stride) for every run
+ * along the innermost dimension of a strided block.  Extents and remote
+ * strides are ordered from the outermost to the innermost dimension of
+ * the packed local buffer. */
+template <class F>
+void remote_strided_runs(const int rank, const size_t* extents,
+                         const size_t* strides, const F& f) {
+  if (rank == 0) {
+    f(0, 0, 1, 1);
+    return;
+  }
+  const size_t inner = extents[rank - 1];
+  size_t outer       = 1;
+  for (int r = 0; r < rank - 1; r++) outer *= extents[r];
+  for (size_t n = 0; n < outer; n++) {
+    size_t idx = n, remote = 0;
+    for (int r = rank - 2; r >= 0; r--) {
+      remote += (idx % extents[r]) * strides[r];
+      idx /= extents[r];
+    }
+    f(n * inner, remote, inner, strides[rank - 1]);
+  }
+}
+
+/* Copies count elements between a local view and the memory of the calling
+ * rank at remote.data() with the DeepCopy of the remote space.  Returns
+ * false if that memory is not host accessible. */
+template <class LocalView, class RemoteView>
+bool remote_local_copy(const LocalView& local, const RemoteView& remote,
+                       const size_t count, const bool put, std::true_type) {
+  typedef typename RemoteView::memory_space remote_space;
+  const size_t bytes = count * sizeof(typename RemoteView::value_type);
+  if (put)
+    Kokkos::Impl::DeepCopy<remote_space, Kokkos::HostSpace>(
+        (void*)remote.data(), local.data(), bytes);
+  else
+    Kokkos::Impl::DeepCopy<Kokkos::HostSpace, remote_space>(
+        (void*)local.data(), remote.data(), bytes);
+  return true;
+}
+
+template <class LocalView, class RemoteView>
+bool remote_local_copy(const LocalView&, const RemoteView&, const size_t,
+                       const bool, std::false_type) {
+  return false;
+}
+
+template <class RemoteView>
+struct RemoteHostAccessible
+    : std::integral_constant<
+          bool, Kokkos::Impl::MemorySpaceAccess<
+                    Kokkos::HostSpace,
+                    typename RemoteView::memory_space>::accessible> {};
+
+/* Copies between a contiguous local view and the partition of the calling
+ * rank of a remote view indexed by rank.  The local view is shaped like
+ * Experimental::local_view of the remote view. */
+template <class LocalView, class RemoteView>
+void remote_partition_copy(const LocalView& local, const RemoteView& remote,
+                           const bool put) {
+  static_assert(std::is_same<typename LocalView::non_const_value_type,
+                             typename RemoteView::non_const_value_type>::value,
+                "deep_copy requires the same value type");
+  static_assert(unsigned(LocalView::rank) + 1 == unsigned(RemoteView::rank),
+                "deep_copy of a partition requires a local view without "
+                "the rank index");
+  static_assert(
+      Kokkos::Impl::MemorySpaceAccess<
+          Kokkos::HostSpace, typename LocalView::memory_space>::accessible,
+      "deep_copy with a remote view requires a host accessible view");
+  typedef typename RemoteView::traits::specialize::backend_type backend_type;
+
+  if (remote.impl_map().pe() >= 0)
+    Kokkos::abort("deep_copy with a remote subview restricted to one rank "
+                  "requires views of the same rank");
+  if (!local.span_is_contiguous() || !remote.span_is_contiguous())
+    Kokkos::abort("deep_copy of a partition requires contiguous views");
+
+  const int my_pe = backend_type::my_pe(remote.impl_map().handle());
+  size_t local_strides[9], remote_strides[9];
+  local.stride(local_strides);
+  remote.stride(remote_strides);
+  size_t count = 1;
+  for (int r = 0; r < int(LocalView::rank); r++) {
+    const size_t extent = r == 0
+                              ? remote.impl_map().partition_extent(my_pe)
+                              : remote.extent(r + 1);
+    if (local.extent(r) != extent ||
+        (extent > 1 && local_strides[r] != remote_strides[r + 1]))
+      Kokkos::abort("deep_copy of a partition requires a local view of the "
+                    "same shape and layout");
+    count *= extent;
+  }
+  if (count == 0) return;
+
+  if (!remote_local_copy(local, remote, count, put,
+                         RemoteHostAccessible<RemoteView>()))
+    Kokkos::abort("deep_copy of a partition requires a host accessible "
+                  "remote space");
+}
+
+/* Copies between a contiguous local view and a remote subview restricted
+ * to one rank, in the memory order of the local view.  Uses the DeepCopy
+ * of the remote space for the packed partition of the calling rank, a
+ * single block transfer when the remote subview has the same packed layout
+ * and a strided transfer otherwise. */
+template <class LocalView, class RemoteView>
+void remote_subview_copy(const LocalView& local, const RemoteView& remote,
+                         const bool put) {
+  static_assert(std::is_same<typename LocalView::non_const_value_type,
+                             typename RemoteView::non_const_value_type>::value,
+                "deep_copy requires the same value type");
+  static_assert(unsigned(LocalView::rank) == unsigned(RemoteView::rank),
+                "deep_copy requires views of the same rank");
+  static_assert(
+      Kokkos::Impl::MemorySpaceAccess<
+          Kokkos::HostSpace, typename LocalView::memory_space>::accessible,
+      "deep_copy with a remote view requires a host accessible view");
+  typedef RemoteBlockTransfer<typename RemoteView::traits::specialize>
+      transfer;
+
+  typedef typename RemoteView::traits::specialize::backend_type backend_type;
+
+  const int pe = remote.impl_map().pe();
+  if (pe < 0)
+    Kokkos::abort("deep_copy of a remote view indexed by rank requires a "
+                  "local view without the rank index");
+  if (!local.span_is_contiguous())
+    Kokkos::abort("deep_copy with a remote view requires a contiguous "
+                  "local view");
+
+  const int rank = RemoteView::rank;
+  size_t local_strides[9], remote_strides[9];
+  local.stride(local_strides);
+  remote.stride(remote_strides);
+  int order[8];
+  for (int r = 0; r < rank; r++) {
+    if (local.extent(r) != remote.extent(r))
+      Kokkos::abort("deep_copy with a remote view requires equal extents");
+    // Insertion sort of the dimensions, outermost in local memory first
+    int k = r;
+    for (; k > 0 && local_strides[order[k - 1]] < local_strides[r]; k--)
+      order[k] = order[k - 1];
+    order[k] = r;
+  }
+
+  size_t extents[8], strides[8], count = 1;
+  bool packed = true;
+  for (int k = rank - 1; k >= 0; k--) {
+    extents[k] = remote.extent(order[k]);
+    strides[k] = remote_strides[order[k]];
+    if (extents[k] > 1 && strides[k] != count) packed = false;
+    count *= extents[k];
+  }
+  if (count == 0) return;
+
+  if (packed && pe == backend_type::my_pe(remote.impl_map().handle()) &&
+      remote_local_copy(local, remote, count, put,
+                        RemoteHostAccessible<RemoteView>()))
+    return;
+
+  if (put) {
+    if (packed)
+      transfer::put(local.data(), remote, pe, 0, count);
+    else
+      transfer::put_strided(local.data(), remote, pe, rank, extents, strides);
+  } else {
+    if (packed)
+      transfer::get(local.data(), remote, pe, 0, count);
+    else
+      transfer::get_strided(local.data(), remote, pe, rank, extents, strides);
+  }
+}
+
+template <class LocalView, class RemoteView>
+void remote_view_copy(const LocalView& local, const RemoteView& remote,
+                      const bool put, std::true_type) {
+  remote_subview_copy(local, remote, put);
+}
+
+template <class LocalView, class RemoteView>
+void remote_view_copy(const LocalView& local, const RemoteView& remote,
+                      const bool put, std::false_type) {
+  remote_partition_copy(local, remote, put);
+}
+
+/* Local views of the same rank copy a subview restricted to one rank,
+ * local views without the rank index copy the partition of the caller */
+template <class LocalView, class RemoteView>
+void remote_view_copy(const LocalView& local, const RemoteView& remote,
+                      const bool put) {
+  remote_view_copy(
+      local, remote, put,
+      std::integral_constant<bool, unsigned(LocalView::rank) ==
+                                       unsigned(RemoteView::rank)>());
+}
+
+}  // namespace Impl
+
+/**\brief Copy a remote subview restricted to one rank, or the partition of
+ *  the calling rank of a remote view, into a local view */
+template <class DT, class... DP, class ST, class... SP>
+inline void deep_copy(
+    const View<DT, DP...>& dst, const View<ST, SP...>& src,
+    typename std::enable_if<
+        std::is_same<typename ViewTraits<DT, DP...>::specialize,
+                     void>::value &&
+        Impl::is_remote_view_specialize<
+            typename ViewTraits<ST, SP...>::specialize>::value>::type* =
+        nullptr) {
+  Impl::remote_view_copy(dst, src, false);
+}
+
+/**\brief Copy a local view into a remote subview restricted to one rank, or
+ *  into the partition of the calling rank of a remote view */
+template <class DT, class... DP, class ST, class... SP>
+inline void deep_copy(
+    const View<DT, DP...>& dst, const View<ST, SP...>& src,
+    typename std::enable_if<
+        Impl::is_remote_view_specialize<
+            typename ViewTraits<DT, DP...>::specialize>::value &&
+        std::is_same<typename ViewTraits<ST, SP...>::specialize,
+                     void>::value>::type* = nullptr) {
+  Impl::remote_view_copy(src, dst, true);
+}
+
+}  // namespace Kokkos
+
+#endif  // KOKKOS_REMOTESPACES_SUBVIEW_HPP
@@ -0,0 +1,924 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  H. Carter Edwards (hcedwar@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOS_REMOTESPACES_VIEWMAPPING_HPP
+#define KOKKOS_REMOTESPACES_VIEWMAPPING_HPP
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+//----------------------------------------------------------------------------
+/** \brief  View mapping shared by the remote spaces.
+ *
+ *  A remote space plugs into the mapping through a backend traits class
+ *  providing
+ *
+ *    memory_space                  the remote memory space
+ *    local_memory_space            space of the memory of a partition
+ *    handle<T>                     handle to the partitions of a view;
+ *                                  handle(pe, i) references element i of
+ *                                  the partition of rank pe
+ *    address<T>                    location of a single element
+ *    num_pes(space)                number of partitions of a space
+ *    my_pe(handle)                 rank of the calling process
+ *    make_handle(ptr[, record])    handle of an allocation
+ *    partition_offsets(record)     prefix sums of the leading partition
+ *                                  extents of an asymmetric allocation,
+ *                                  NULL if symmetric
+ *    shift(handle, offset)         handle moved by offset elements
+ *    direct(address)               local pointer to the element or NULL
+ *    get, put, get_async           element transfers
+ *    has_fetch_op<T, Op>           whether fetch_op<Op> and atomic_op<Op>
+ *                                  are available for T
+ *    fence(handle)                 completes the operations on a view
+ *
+ *  Everything is resolved at compile time, so each operator on a remote
+ *  element compiles to the best primitive of its backend.
+ */
+namespace Kokkos {
+namespace Impl {
+
+template <class Backend>
+struct RemoteSpaceSpecializeTag {
+  typedef Backend backend_type;
+};
+
+template <class Backend>
+struct is_remote_view_specialize<RemoteSpaceSpecializeTag<Backend>>
+    : std::true_type {};
+
+template <class DstTraits, class SrcTraits, class Backend>
+class ViewMapping<DstTraits, SrcTraits, RemoteSpaceSpecializeTag<Backend>>
+    : public RemoteViewMappingAssign<DstTraits, SrcTraits> {};
+
+/* Read-modify-write operations a backend may provide natively */
+
+struct RemoteSumOp {
+  template <class T>
+  KOKKOS_INLINE_FUNCTION static T apply(const T& a, const T& b) {
+    return a + b;
+  }
+};
+
+struct RemoteProdOp {
+  template <class T>
+  KOKKOS_INLINE_FUNCTION static T apply(const T& a, const T& b) {
+    return a * b;
+  }
+};
+
+struct RemoteBandOp {
+  template <class T>
+  KOKKOS_INLINE_FUNCTION static T apply(const T& a, const T& b) {
+    return a & b;
+  }
+};
+
+struct RemoteBorOp {
+  template <class T>
+  KOKKOS_INLINE_FUNCTION static T apply(const T& a, const T& b) {
+    return a | b;
+  }
+};
+
+struct RemoteBxorOp {
+  template <class T>
+  KOKKOS_INLINE_FUNCTION static T apply(const T& a, const T& b) {
+    return a ^ b;
+  }
+};
+
+template <class Backend, class T>
+struct RemoteDataElement {
+  typedef const T const_value_type;
+  typedef T non_const_value_type;
+  typedef typename Backend::template address<T> address_type;
+  address_type addr;
+
+  KOKKOS_INLINE_FUNCTION
+  explicit RemoteDataElement(const address_type& addr_) : addr(addr_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  RemoteDataElement(const RemoteDataElement&) = default;
+
+  KOKKOS_INLINE_FUNCTION
+  T load() const {
+    if (T* ptr = Backend::direct(addr)) return *ptr;
+    return Backend::get(addr);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void load_async(T& val) const {
+    if (T* ptr = Backend::direct(addr))
+      val = *ptr;
+    else
+      Backend::get_async(addr, val);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void store(const_value_type& val) const {
+    if (T* ptr = Backend::direct(addr))
+      *ptr = val;
+    else
+      Backend::put(addr, val);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator=(const_value_type& val) const {
+    store(val);
+    return val;
+  }
+
+  // Assigning one element to another copies the value, not the address
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator=(const RemoteDataElement& rhs) const {
+    return *this = rhs.load();
+  }
+
+ private:
+  // A native fetch operation is atomic with respect to other ranks updating
+  // the same element.  Backends without one fall back to a get and a put.
+
+  template <class Op>
+  KOKKOS_INLINE_FUNCTION T fetch(const T& val, std::true_type) const {
+    return Backend::template fetch_op<Op>(addr, val);
+  }
+
+  template <class Op>
+  KOKKOS_INLINE_FUNCTION T fetch(const T& val, std::false_type) const {
+    T tmp = load();
+    store(Op::apply(tmp, val));
+    return tmp;
+  }
+
+  template <class Op>
+  KOKKOS_INLINE_FUNCTION void update(const T& val, std::true_type) const {
+    Backend::template atomic_op<Op>(addr, val);
+  }
+
+  template <class Op>
+  KOKKOS_INLINE_FUNCTION void update(const T& val, std::false_type) const {
+    store(Op::apply(load(), val));
+  }
+
+ public:
+  /** \brief  Applies Op to the element and returns its previous value */
+  template <class Op>
+  KOKKOS_INLINE_FUNCTION T fetch(const T& val) const {
+    return fetch<Op>(val, typename Backend::template has_fetch_op<T, Op>());
+  }
+
+  /** \brief  Applies Op to the element without fetching it */
+  template <class Op>
+  KOKKOS_INLINE_FUNCTION void update(const T& val) const {
+    update<Op>(val, typename Backend::template has_fetch_op<T, Op>());
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void inc() const { update<RemoteSumOp>(T(1)); }
+
+  KOKKOS_INLINE_FUNCTION
+  void dec() const { update<RemoteSumOp>(T(-1)); }
+
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator++() const {
+    return fetch<RemoteSumOp>(T(1)) + T(1);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator--() const {
+    return fetch<RemoteSumOp>(T(-1)) - T(1);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator++(int) const { return fetch<RemoteSumOp>(T(1)); }
+
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator--(int) const { return fetch<RemoteSumOp>(T(-1)); }
+
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator+=(const_value_type& val) const {
+    return fetch<RemoteSumOp>(val) + val;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator-=(const_value_type& val) const {
+    return fetch<RemoteSumOp>(-val) - val;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator*=(const_value_type& val) const {
+    return fetch<RemoteProdOp>(val) * val;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator&=(const_value_type& val) const {
+    return fetch<RemoteBandOp>(val) & val;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator^=(const_value_type& val) const {
+    return fetch<RemoteBxorOp>(val) ^ val;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator|=(const_value_type& val) const {
+    return fetch<RemoteBorOp>(val) | val;
+  }
+
+  // No backend provides these natively, they remain a get and a put.
+
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator/=(const_value_type& val) const {
+    T tmp = load();
+    tmp /= val;
+    store(tmp);
+    return tmp;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator%=(const_value_type& val) const {
+    T tmp = load();
+    tmp %= val;
+    store(tmp);
+    return tmp;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator<<=(const_value_type& val) const {
+    T tmp = load();
+    tmp <<= val;
+    store(tmp);
+    return tmp;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator>>=(const_value_type& val) const {
+    T tmp = load();
+    tmp >>= val;
+    store(tmp);
+    return tmp;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator+(const_value_type& val) const {
+    T tmp = load();
+    return tmp + val;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator-(const_value_type& val) const {
+    T tmp = load();
+    return tmp - val;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator*(const_value_type& val) const {
+    T tmp = load();
+    return tmp * val;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator/(const_value_type& val) const {
+    T tmp = load();
+    return tmp / val;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator%(const_value_type& val) const {
+    T tmp = load();
+    return tmp % val;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator!() const {
+    T tmp = load();
+    return !tmp;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator&&(const_value_type& val) const {
+    T tmp = load();
+    return tmp && val;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator||(const_value_type& val) const {
+    T tmp = load();
+    return tmp || val;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator&(const_value_type& val) const {
+    T tmp = load();
+    return tmp & val;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator|(const_value_type& val) const {
+    T tmp = load();
+    return tmp | val;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator^(const_value_type& val) const {
+    T tmp = load();
+    return tmp ^ val;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator~() const {
+    T tmp = load();
+    return ~tmp;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator<<(const unsigned int& val) const {
+    T tmp = load();
+    return tmp << val;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  const_value_type operator>>(const unsigned int& val) const {
+    T tmp = load();
+    return tmp >> val;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  bool operator==(const_value_type& val) const {
+    T tmp = load();
+    return tmp == val;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  bool operator!=(const_value_type& val) const {
+    T tmp = load();
+    return tmp != val;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  bool operator>=(const_value_type& val) const {
+    T tmp = load();
+    return tmp >= val;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  bool operator<=(const_value_type& val) const {
+    T tmp = load();
+    return tmp <= val;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  bool operator<(const_value_type& val) const {
+    T tmp = load();
+    return tmp < val;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  bool operator>(const_value_type& val) const {
+    T tmp = load();
+    return tmp > val;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  operator const_value_type() const { return load(); }
+};
+
+template <class Traits>
+struct ViewDataHandle<
+    Traits, typename std::enable_if<is_remote_view_specialize<
+                typename Traits::specialize>::value>::type> {
+  typedef typename Traits::specialize::backend_type backend_type;
+  typedef typename Traits::value_type value_type;
+  typedef typename backend_type::template handle<value_type> handle_type;
+  typedef decltype(std::declval<const handle_type&>()(0, size_t(0)))
+      return_type;
+  typedef Kokkos::Impl::SharedAllocationTracker track_type;
+
+  KOKKOS_INLINE_FUNCTION
+  static handle_type assign(value_type* arg_data_ptr,
+                            track_type const& arg_tracker) {
+    return backend_type::make_handle(
+        arg_data_ptr, arg_tracker.template get_record<
+                          typename backend_type::memory_space>());
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  static handle_type assign(handle_type const arg_handle, size_t offset) {
+    return backend_type::shift(arg_handle, offset);
+  }
+};
+
+/** \brief  View traits of a remote memory space */
+template <class Space, class Tag, class... Prop>
+struct RemoteSpaceViewTraits {
+  // Specify Space, memory traits should be the only subsequent argument.
+
+  static_assert(
+      std::is_same<typename ViewTraits<void, Prop...>::execution_space,
+                   void>::value &&
+          std::is_same<typename ViewTraits<void, Prop...>::memory_space,
+                       void>::value &&
+          std::is_same<typename ViewTraits<void, Prop...>::HostMirrorSpace,
+                       void>::value &&
+          std::is_same<typename ViewTraits<void, Prop...>::array_layout,
+                       void>::value,
+      "Only one View Execution or Memory Space template argument");
+
+  typedef typename Space::execution_space execution_space;
+  typedef typename Space::memory_space memory_space;
+  typedef typename Kokkos::Impl::HostMirror<Space>::Space HostMirrorSpace;
+  typedef typename execution_space::array_layout array_layout;
+  typedef typename ViewTraits<void, Prop...>::memory_traits memory_traits;
+  typedef Tag specialize;
+};
+
+template <class Traits, class Backend>
+class ViewMapping<Traits, RemoteSpaceSpecializeTag<Backend>> {
+ private:
+  template <class, class...>
+  friend class ViewMapping;
+  template <class, class...>
+  friend class Kokkos::View;
+
+  typedef ViewOffset<typename Traits::dimension, typename Traits::array_layout,
+                     void>
+      offset_type;
+
+  typedef typename ViewDataHandle<Traits>::handle_type handle_type;
+
+  handle_type m_handle;
+  offset_type m_offset;
+  int m_num_pes;
+  // Rank a subview is restricted to, -1 if the leading index is the rank
+  int m_pe;
+  // Partition offsets of an asymmetric allocation, owned by its record.
+  // Dimension 1 of m_offset then spans the largest partition.
+  const int64_t* m_partition;
+
+  KOKKOS_INLINE_FUNCTION
+  ViewMapping(const handle_type& arg_handle, const offset_type& arg_offset)
+      : m_handle(arg_handle),
+        m_offset(arg_offset),
+        m_pe(-1),
+        m_partition(NULL) {}
+
+  // Bounds of an index into a partition narrower than dimension 1
+  template <typename I0, typename I1>
+  KOKKOS_FORCEINLINE_FUNCTION void check_partition(const I0& i0,
+                                                   const I1& i1) const {
+#ifdef KOKKOS_ENABLE_DEBUG_BOUNDS_CHECK
+    if (m_pe < 0 && m_partition && size_t(i1) >= partition_extent(i0))
+      Kokkos::abort("Remote view index beyond the partition of its rank");
+#else
+    (void)i0;
+    (void)i1;
+#endif
+  }
+
+ public:
+  typedef void printable_label_typedef;
+  enum { is_managed = Traits::is_managed };
+
+  //----------------------------------------
+  // Domain dimensions
+
+  enum { Rank = Traits::dimension::rank };
+
+  template <typename iType>
+  KOKKOS_INLINE_FUNCTION constexpr size_t extent(const iType& r) const {
+    return m_offset.m_dim.extent(r);
+  }
+
+  KOKKOS_INLINE_FUNCTION constexpr typename Traits::array_layout layout()
+      const {
+    return m_offset.layout();
+  }
+
+  KOKKOS_INLINE_FUNCTION constexpr size_t dimension_0() const {
+    return m_pe < 0 ? m_num_pes : m_offset.dimension_0();
+  }
+  KOKKOS_INLINE_FUNCTION constexpr size_t dimension_1() const {
+    return m_offset.dimension_1();
+  }
+  KOKKOS_INLINE_FUNCTION constexpr size_t dimension_2() const {
+    return m_offset.dimension_2();
+  }
+  KOKKOS_INLINE_FUNCTION constexpr size_t dimension_3() const {
+    return m_offset.dimension_3();
+  }
+  KOKKOS_INLINE_FUNCTION constexpr size_t dimension_4() const {
+    return m_offset.dimension_4();
+  }
+  KOKKOS_INLINE_FUNCTION constexpr size_t dimension_5() const {
+    return m_offset.dimension_5();
+  }
+  KOKKOS_INLINE_FUNCTION constexpr size_t dimension_6() const {
+    return m_offset.dimension_6();
+  }
+  KOKKOS_INLINE_FUNCTION constexpr size_t dimension_7() const {
+    return m_offset.dimension_7();
+  }
+
+  // Is a regular layout with uniform striding for each index.
+  using is_regular = typename offset_type::is_regular;
+
+  KOKKOS_INLINE_FUNCTION constexpr size_t stride_0() const {
+    return m_offset.stride_0();
+  }
+  KOKKOS_INLINE_FUNCTION constexpr size_t stride_1() const {
+    return m_offset.stride_1();
+  }
+  KOKKOS_INLINE_FUNCTION constexpr size_t stride_2() const {
+    return m_offset.stride_2();
+  }
+  KOKKOS_INLINE_FUNCTION constexpr size_t stride_3() const {
+    return m_offset.stride_3();
+  }
+  KOKKOS_INLINE_FUNCTION constexpr size_t stride_4() const {
+    return m_offset.stride_4();
+  }
+  KOKKOS_INLINE_FUNCTION constexpr size_t stride_5() const {
+    return m_offset.stride_5();
+  }
+  KOKKOS_INLINE_FUNCTION constexpr size_t stride_6() const {
+    return m_offset.stride_6();
+  }
+  KOKKOS_INLINE_FUNCTION constexpr size_t stride_7() const {
+    return m_offset.stride_7();
+  }
+
+  template <typename iType>
+  KOKKOS_INLINE_FUNCTION void stride(iType* const s) const {
+    m_offset.stride(s);
+  }
+
+  //----------------------------------------
+  // Range span
+
+  /** \brief  Span of the mapped range */
+  KOKKOS_INLINE_FUNCTION constexpr size_t span() const {
+    return m_offset.span();
+  }
+
+  /** \brief  Is the mapped range span contiguous */
+  KOKKOS_INLINE_FUNCTION constexpr bool span_is_contiguous() const {
+    return m_offset.span_is_contiguous();
+  }
+
+  typedef typename ViewDataHandle<Traits>::return_type reference_type;
+  typedef typename Traits::value_type* pointer_type;
+
+  /** \brief  Query raw pointer to memory */
+  KOKKOS_INLINE_FUNCTION constexpr pointer_type data() const {
+    return m_handle.ptr;
+  }
+
+  /** \brief  Rank a subview is restricted to, -1 if none */
+  KOKKOS_INLINE_FUNCTION constexpr int pe() const { return m_pe; }
+
+  /** \brief  Number of partitions */
+  KOKKOS_INLINE_FUNCTION constexpr int num_pes() const { return m_num_pes; }
+
+  /** \brief  Prefix sums of the leading partition extents, NULL if the
+   *  partitions are symmetric */
+  KOKKOS_INLINE_FUNCTION constexpr const int64_t* partition_offsets() const {
+    return m_partition;
+  }
+
+  /** \brief  Extent of dimension 1 in the partition of rank pe */
+  KOKKOS_INLINE_FUNCTION constexpr size_t partition_extent(
+      const int pe) const {
+    return m_partition ? size_t(m_partition[pe + 1] - m_partition[pe])
+                       : m_offset.dimension_1();
+  }
+
+  /** \brief  Index along dimension 1 of the first element of the partition
+   *  of rank pe, with partitions numbered in rank order */
+  KOKKOS_INLINE_FUNCTION constexpr size_t partition_offset(
+      const int pe) const {
+    return m_partition ? size_t(m_partition[pe])
+                       : size_t(pe) * m_offset.dimension_1();
+  }
+
+  /** \brief  Query the handle to the remote partitions */
+  KOKKOS_INLINE_FUNCTION constexpr const handle_type& handle() const {
+    return m_handle;
+  }
+
+  //----------------------------------------
+  // The View class performs all rank and bounds checking before
+  // calling these element reference methods.
+
+  KOKKOS_FORCEINLINE_FUNCTION
+  reference_type reference() const { return m_handle(m_pe, 0); }
+
+  template <typename I0>
+  KOKKOS_FORCEINLINE_FUNCTION
+      typename std::enable_if<std::is_integral<I0>::value &&
+                                  !std::is_same<typename Traits::array_layout,
+                                                Kokkos::LayoutStride>::value,
+                              reference_type>::type
+      reference(const I0& i0) const {
+    return m_pe < 0 ? m_handle(i0, 0) : m_handle(m_pe, m_offset(i0));
+  }
+
+  template <typename I0>
+  KOKKOS_FORCEINLINE_FUNCTION
+      typename std::enable_if<std::is_integral<I0>::value &&
+                                  std::is_same<typename Traits::array_layout,
+                                               Kokkos::LayoutStride>::value,
+                              reference_type>::type
+      reference(const I0& i0) const {
+    return m_pe < 0 ? m_handle(i0, 0) : m_handle(m_pe, m_offset(i0));
+  }
+
+  template <typename I0, typename I1>
+  KOKKOS_FORCEINLINE_FUNCTION reference_type reference(const I0& i0,
+                                                       const I1& i1) const {
+    check_partition(i0, i1);
+    return m_pe < 0 ? m_handle(i0, m_offset(0, i1))
+                    : m_handle(m_pe, m_offset(i0, i1));
+  }
+
+  template <typename I0, typename I1, typename I2>
+  KOKKOS_FORCEINLINE_FUNCTION reference_type reference(const I0& i0,
+                                                       const I1& i1,
+                                                       const I2& i2) const {
+    check_partition(i0, i1);
+    return m_pe < 0 ? m_handle(i0, m_offset(0, i1, i2))
+                    : m_handle(m_pe, m_offset(i0, i1, i2));
+  }
+
+  template <typename I0, typename I1, typename I2, typename I3>
+  KOKKOS_FORCEINLINE_FUNCTION reference_type
+  reference(const I0& i0, const I1& i1, const I2& i2, const I3& i3) const {
+    check_partition(i0, i1);
+    return m_pe < 0 ? m_handle(i0, m_offset(0, i1, i2, i3))
+                    : m_handle(m_pe, m_offset(i0, i1, i2, i3));
+  }
+
+  template <typename I0, typename I1, typename I2, typename I3, typename I4>
+  KOKKOS_FORCEINLINE_FUNCTION reference_type reference(const I0& i0,
+                                                       const I1& i1,
+                                                       const I2& i2,
+                                                       const I3& i3,
+                                                       const I4& i4) const {
+    check_partition(i0, i1);
+    return m_pe < 0 ? m_handle(i0, m_offset(0, i1, i2, i3, i4))
+                    : m_handle(m_pe, m_offset(i0, i1, i2, i3, i4));
+  }
+
+  template <typename I0, typename I1, typename I2, typename I3, typename I4,
+            typename I5>
+  KOKKOS_FORCEINLINE_FUNCTION reference_type
+  reference(const I0& i0, const I1& i1, const I2& i2, const I3& i3,
+            const I4& i4, const I5& i5) const {
+    check_partition(i0, i1);
+    return m_pe < 0 ? m_handle(i0, m_offset(0, i1, i2, i3, i4, i5))
+                    : m_handle(m_pe, m_offset(i0, i1, i2, i3, i4, i5));
+  }
+
+  template <typename I0, typename I1, typename I2, typename I3, typename I4,
+            typename I5, typename I6>
+  KOKKOS_FORCEINLINE_FUNCTION reference_type
+  reference(const I0& i0, const I1& i1, const I2& i2, const I3& i3,
+            const I4& i4, const I5& i5, const I6& i6) const {
+    check_partition(i0, i1);
+    return m_pe < 0 ? m_handle(i0, m_offset(0, i1, i2, i3, i4, i5, i6))
+                    : m_handle(m_pe, m_offset(i0, i1, i2, i3, i4, i5, i6));
+  }
+
+  template <typename I0, typename I1, typename I2, typename I3, typename I4,
+            typename I5, typename I6, typename I7>
+  KOKKOS_FORCEINLINE_FUNCTION reference_type
+  reference(const I0& i0, const I1& i1, const I2& i2, const I3& i3,
+            const I4& i4, const I5& i5, const I6& i6, const I7& i7) const {
+    check_partition(i0, i1);
+    return m_pe < 0 ? m_handle(i0, m_offset(0, i1, i2, i3, i4, i5, i6, i7))
+                    : m_handle(m_pe, m_offset(i0, i1, i2, i3, i4, i5, i6, i7));
+  }
+
+  //----------------------------------------
+
+ private:
+  enum { MemorySpanMask = 8 - 1 /* Force alignment on 8 byte boundary */ };
+  enum { MemorySpanSize = sizeof(typename Traits::value_type) };
+
+ public:
+  /** \brief  Span, in bytes, of the referenced memory */
+  KOKKOS_INLINE_FUNCTION constexpr size_t memory_span() const {
+    return (m_offset.span() * sizeof(typename Traits::value_type) +
+            MemorySpanMask) &
+           ~size_t(MemorySpanMask);
+  }
+
+  //----------------------------------------
+
+  KOKKOS_INLINE_FUNCTION ~ViewMapping() {}
+  KOKKOS_INLINE_FUNCTION ViewMapping()
+      : m_handle(), m_offset(), m_num_pes(0), m_pe(-1), m_partition(NULL) {}
+  KOKKOS_INLINE_FUNCTION ViewMapping(const ViewMapping& rhs)
+      : m_handle(rhs.m_handle),
+        m_offset(rhs.m_offset),
+        m_num_pes(rhs.m_num_pes),
+        m_pe(rhs.m_pe),
+        m_partition(rhs.m_partition) {}
+  KOKKOS_INLINE_FUNCTION ViewMapping& operator=(const ViewMapping& rhs) {
+    m_handle    = rhs.m_handle;
+    m_offset    = rhs.m_offset;
+    m_num_pes   = rhs.m_num_pes;
+    m_pe        = rhs.m_pe;
+    m_partition = rhs.m_partition;
+    return *this;
+  }
+
+  KOKKOS_INLINE_FUNCTION ViewMapping(ViewMapping&& rhs)
+      : m_handle(rhs.m_handle),
+        m_offset(rhs.m_offset),
+        m_num_pes(rhs.m_num_pes),
+        m_pe(rhs.m_pe),
+        m_partition(rhs.m_partition) {}
+  KOKKOS_INLINE_FUNCTION ViewMapping& operator=(ViewMapping&& rhs) {
+    m_handle    = rhs.m_handle;
+    m_offset    = rhs.m_offset;
+    m_num_pes   = rhs.m_num_pes;
+    m_pe        = rhs.m_pe;
+    m_partition = rhs.m_partition;
+    return *this;
+  }
+
+  //----------------------------------------
+
+  /**\brief  Span, in bytes, of the required memory */
+  KOKKOS_INLINE_FUNCTION
+  static constexpr size_t memory_span(
+      typename Traits::array_layout const& arg_layout) {
+    typedef std::integral_constant<unsigned, 0> padding;
+    return (offset_type(padding(), arg_layout).span() * MemorySpanSize +
+            MemorySpanMask) &
+           ~size_t(MemorySpanMask);
+  }
+
+  /**\brief  Wrap a span of memory */
+  template <class... P>
+  KOKKOS_INLINE_FUNCTION ViewMapping(
+      Kokkos::Impl::ViewCtorProp<P...> const& arg_prop,
+      typename Traits::array_layout const& arg_layout)
+      : m_handle(Backend::make_handle(
+            ((Kokkos::Impl::ViewCtorProp<void, pointer_type> const&)arg_prop)
+                .value)),
+        m_pe(-1),
+        m_partition(NULL) {
+    typedef typename Traits::value_type value_type;
+    typedef std::integral_constant<
+        unsigned, Kokkos::Impl::ViewCtorProp<P...>::allow_padding
+                      ? sizeof(value_type)
+                      : 0>
+        padding;
+
+    // A wrapped pointer carries no space, the leading extent gives the
+    // number of partitions
+    typename Traits::array_layout layout;
+    for (int i = 0; i < Traits::rank; i++)
+      layout.dimension[i] = arg_layout.dimension[i];
+    m_num_pes           = arg_layout.dimension[0];
+    layout.dimension[0] = 1;
+    m_offset            = offset_type(padding(), layout);
+  }
+
+  /**\brief  Assign data */
+  KOKKOS_INLINE_FUNCTION
+  void assign_data(pointer_type arg_ptr) {
+    m_handle = Backend::make_handle(arg_ptr);
+  }
+
+  //----------------------------------------
+  /*  Allocate and construct mapped array.
+   *  Allocate via shared allocation record and
+   *  return that record for allocation tracking.
+   */
+  template <class... P>
+  Kokkos::Impl::SharedAllocationRecord<>* allocate_shared(
+      Kokkos::Impl::ViewCtorProp<P...> const& arg_prop,
+      typename Traits::array_layout const& arg_layout) {
+    typedef Kokkos::Impl::ViewCtorProp<P...> alloc_prop;
+
+    typedef typename alloc_prop::execution_space execution_space;
+    typedef typename Traits::memory_space memory_space;
+    typedef typename Traits::value_type value_type;
+    typedef ViewValueFunctor<execution_space, value_type> functor_type;
+    typedef Kokkos::Impl::SharedAllocationRecord<memory_space, functor_type>
+        record_type;
+
+    // Query the mapping for byte-size of allocation.
+    // If padding is allowed then pass in sizeof value type
+    // for padding computation.
+    typedef std::integral_constant<
+        unsigned, alloc_prop::allow_padding ? sizeof(value_type) : 0>
+        padding;
+
+    typename Traits::array_layout layout;
+    for (int i = 0; i < Traits::rank; i++)
+      layout.dimension[i] = arg_layout.dimension[i];
+    layout.dimension[0] = 1;
+    m_offset            = offset_type(padding(), layout);
+    const memory_space& space =
+        ((Kokkos::Impl::ViewCtorProp<void, memory_space> const&)arg_prop).value;
+    m_num_pes = Backend::num_pes(space);
+    const size_t alloc_size =
+        (m_offset.span() * MemorySpanSize + MemorySpanMask) &
+        ~size_t(MemorySpanMask);
+
+    // Create shared memory tracking record with allocate memory from the memory
+    // space
+    record_type* const record = record_type::allocate(
+        space,
+        ((Kokkos::Impl::ViewCtorProp<void, std::string> const&)arg_prop).value,
+        alloc_size);
+
+#ifdef KOKKOS_ENABLE_DEPRECATED_CODE
+    if (alloc_size) {
+#endif
+      m_handle = Backend::make_handle(
+          reinterpret_cast<pointer_type>(record->data()), record);
+#ifdef KOKKOS_ENABLE_DEPRECATED_CODE
+    }
+#endif
+
+    // Dimension 1 of an asymmetric view spans the largest partition so
+    // that any element of any rank is in bounds.  Strides of LayoutRight
+    // do not depend on it, peers share the offsets of the local partition.
+    m_partition = Backend::partition_offsets(record);
+    if (m_partition) {
+      for (int pe = 0; pe < m_num_pes; pe++)
+        layout.dimension[1] =
+            std::max(layout.dimension[1], partition_extent(pe));
+      m_offset = offset_type(padding(), layout);
+    }
+
+    //  Only initialize if the allocation is non-zero.
+    //  May be zero if one of the dimensions is zero.
+    if (alloc_size && alloc_prop::initialize) {
+      // Assume destruction is only required when construction is requested.
+      // The ViewValueFunctor has both value construction and destruction
+      // operators.
+      /*record->m_destroy = functor_type( (
+         (Kokkos::Impl::ViewCtorProp<void,execution_space> const &)
+         arg_prop).value , (value_type *) m_handle , m_offset.span()
+                                      );*/
+
+      // Construct values
+      record->m_destroy.construct_shared_allocation();
+    }
+
+    return record;
+  }
+};
+
+
+}  // namespace Impl
+}  // namespace Kokkos
+
+#endif  // KOKKOS_REMOTESPACES_VIEWMAPPING_HPP
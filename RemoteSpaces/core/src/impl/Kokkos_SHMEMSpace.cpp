@@ -49,8 +49,92 @@
 
 namespace Kokkos {
 
+namespace {
+
+// Collectives over all PEs work on symmetric static data
+long shmem_reduce_psync[SHMEM_REDUCE_SYNC_SIZE];
+long long shmem_reduce_pwrk[SHMEM_REDUCE_MIN_WRKDATA_SIZE];
+long shmem_collect_psync[SHMEM_COLLECT_SYNC_SIZE];
+long long shmem_collective_src;
+long long shmem_collective_dst;
+
+long long shmem_max_all(const long long value) {
+  for (int i = 0; i < SHMEM_REDUCE_SYNC_SIZE; i++)
+    shmem_reduce_psync[i] = SHMEM_SYNC_VALUE;
+  shmem_collective_src = value;
+  shmem_barrier_all();
+  shmem_longlong_max_to_all(&shmem_collective_dst, &shmem_collective_src, 1,
+                            0, 0, shmem_n_pes(), shmem_reduce_pwrk,
+                            shmem_reduce_psync);
+  const long long result = shmem_collective_dst;
+  shmem_barrier_all();
+  return result;
+}
+
+std::vector<long long> shmem_collect_all(const SHMEMSpace& space,
+                                         const long long value) {
+  const int num_pes = shmem_n_pes();
+  long long* values =
+      static_cast<long long*>(shmem_malloc(num_pes * sizeof(long long)));
+#ifdef KOKKOS_ENABLE_SHMEM_TEAMS
+  if (space.team != SHMEM_TEAM_WORLD) {
+    // Only the team takes part, shmem_free synchronizes all PEs
+    std::vector<long long> result;
+    shmem_collective_src = value;
+    if (space.team != SHMEM_TEAM_INVALID) {
+      shmem_longlong_fcollect(space.team, values, &shmem_collective_src, 1);
+      result.assign(values, values + space.num_pes());
+    }
+    shmem_free(values);
+    return result;
+  }
+#endif
+  for (int i = 0; i < SHMEM_COLLECT_SYNC_SIZE; i++)
+    shmem_collect_psync[i] = SHMEM_SYNC_VALUE;
+  shmem_collective_src = value;
+  shmem_barrier_all();
+  shmem_fcollect64(values, &shmem_collective_src, 1, 0, 0, num_pes,
+                   shmem_collect_psync);
+  std::vector<long long> result(values, values + num_pes);
+  shmem_free(values);
+  return result;
+}
+
+}  // namespace
+
+bool SHMEMSpace::nonblocking_puts         = false;
+size_t SHMEMSpace::nonblocking_chunk_size = 65536;
+
 /* Default allocation mechanism */
-SHMEMSpace::SHMEMSpace() : rank_list(NULL), allocation_mode(Symmetric) {}
+SHMEMSpace::SHMEMSpace()
+    : rank_list(NULL), allocation_mode(Symmetric), extent(0) {
+#ifdef KOKKOS_ENABLE_SHMEM_TEAMS
+  team = SHMEM_TEAM_WORLD;
+#endif
+}
+
+#ifdef KOKKOS_ENABLE_SHMEM_TEAMS
+SHMEMSpace::SHMEMSpace(const shmem_team_t &team_)
+    : team(team_), rank_list(NULL), allocation_mode(Symmetric), extent(0) {}
+#endif
+
+int SHMEMSpace::num_pes() const {
+#ifdef KOKKOS_ENABLE_SHMEM_TEAMS
+  if (team == SHMEM_TEAM_INVALID) return 0;
+  return shmem_team_n_pes(team);
+#else
+  return shmem_n_pes();
+#endif
+}
+
+int SHMEMSpace::my_pe() const {
+#ifdef KOKKOS_ENABLE_SHMEM_TEAMS
+  if (team == SHMEM_TEAM_INVALID) return -1;
+  return shmem_team_my_pe(team);
+#else
+  return shmem_my_pe();
+#endif
+}
 
 void SHMEMSpace::impl_set_rank_list(int *const rank_list_) {
   rank_list = rank_list_;
@@ -79,8 +163,14 @@ void *SHMEMSpace::allocate(const size_t arg_alloc_size) const {
       int num_pes = shmem_n_pes();
       int my_id   = shmem_my_pe();
       ptr         = shmem_malloc(arg_alloc_size);
+    } else if (allocation_mode == Kokkos::Asymmetric) {
+      // The symmetric heap requires the same size on every PE, so each PE
+      // holds as much memory as the largest partition
+      ptr = shmem_malloc(shmem_max_all(arg_alloc_size));
     } else {
-      Kokkos::abort("SHMEMSpace only supports symmetric allocation policy.");
+      Kokkos::abort(
+          "SHMEMSpace only supports symmetric and asymmetric allocation "
+          "policies.");
     }
   }
   return ptr;
@@ -90,7 +180,34 @@ void SHMEMSpace::deallocate(void *const arg_alloc_ptr, const size_t) const {
   shmem_free(arg_alloc_ptr);
 }
 
-void SHMEMSpace::fence() { shmem_barrier_all(); }
+void SHMEMSpace::fence() {
+  const uint64_t ticket = Impl::shmem_begin_staged_release();
+#ifdef KOKKOS_ENABLE_SHMEM_TEAMS
+  if (team != SHMEM_TEAM_WORLD) {
+    // Team synchronization does not complete outstanding operations
+    shmem_quiet();
+    if (team != SHMEM_TEAM_INVALID) shmem_team_sync(team);
+  } else {
+    shmem_barrier_all();
+  }
+#else
+  shmem_barrier_all();
+#endif
+  Impl::shmem_end_staged_release(ticket);
+}
+
+void SHMEMSpace::wait_all() {
+  const uint64_t ticket = Impl::shmem_begin_staged_release();
+  shmem_quiet();
+  Impl::shmem_end_staged_release(ticket);
+}
+
+void SHMEMSpace::set_nonblocking_puts(const bool enable,
+                                      const size_t chunk_size) {
+  if (nonblocking_puts && !enable) SHMEMSpace().wait_all();
+  nonblocking_puts       = enable;
+  nonblocking_chunk_size = chunk_size;
+}
 
 }  // namespace Kokkos
 
@@ -148,6 +265,33 @@ SharedAllocationRecord<Kokkos::SHMEMSpace, void>::SharedAllocationRecord(
 
   strncpy(RecordBase::m_alloc_ptr->m_label, arg_label.c_str(),
           SharedAllocationHeader::maximum_label_length);
+
+  if (m_space.allocation_mode == Kokkos::Asymmetric) {
+    const std::vector<long long> extents =
+        shmem_collect_all(m_space, m_space.extent);
+    partition_offsets.assign(extents.size() + 1, 0);
+    for (size_t r = 0; r < extents.size(); r++)
+      partition_offsets[r + 1] = partition_offsets[r] + extents[r];
+  }
+
+  const int num_pes = m_space.num_pes();
+#ifdef KOKKOS_ENABLE_SHMEM_TEAMS
+  if (m_space.team != SHMEM_TEAM_WORLD) {
+    team_pes.resize(num_pes);
+    for (int pe = 0; pe < num_pes; pe++)
+      team_pes[pe] =
+          shmem_team_translate_pe(m_space.team, pe, SHMEM_TEAM_WORLD);
+  }
+#endif
+
+  // Peers reachable through shared memory are accessed with loads and stores
+  std::vector<void *> ptrs(num_pes, NULL);
+  bool reachable = false;
+  for (int pe = 0; pe < num_pes; pe++) {
+    ptrs[pe] = shmem_ptr(data(), team_pes.empty() ? pe : team_pes[pe]);
+    reachable |= ptrs[pe] != NULL;
+  }
+  if (reachable) peer_ptrs.swap(ptrs);
 }
 
 //----------------------------------------------------------------------------
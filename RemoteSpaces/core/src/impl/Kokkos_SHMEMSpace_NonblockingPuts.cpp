@@ -0,0 +1,131 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  H. Carter Edwards (hcedwar@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_SHMEMSpace.hpp>
+#include <shmem.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+
+namespace Kokkos {
+namespace Impl {
+
+namespace {
+
+/* Source memory of the non-blocking puts issued by one thread.  The
+ * buffer is never reallocated while puts from it may be in flight, and
+ * only its owning thread touches it. */
+struct SHMEMStagingBuffer {
+  std::unique_ptr<char[]> data;
+  size_t capacity = 0;
+  size_t used     = 0;
+  // Last release ticket handed out when its latest put was issued
+  uint64_t ticket = 0;
+};
+
+/* Buffers outlive their threads, puts from them may still be in flight */
+std::mutex staging_buffers_mutex;
+std::vector<std::unique_ptr<SHMEMStagingBuffer>> staging_buffers;
+
+SHMEMStagingBuffer &thread_staging_buffer() {
+  thread_local SHMEMStagingBuffer *buffer = nullptr;
+  if (buffer == nullptr) {
+    std::lock_guard<std::mutex> lock(staging_buffers_mutex);
+    staging_buffers.emplace_back(new SHMEMStagingBuffer());
+    buffer = staging_buffers.back().get();
+  }
+  return *buffer;
+}
+
+/* Quiets take a ticket before they start and publish the highest finished
+ * one.  A finished ticket above the one a thread read after its last put
+ * means that put was complete. */
+std::atomic<uint64_t> release_tickets(0);
+std::atomic<uint64_t> released_ticket(0);
+
+}  // namespace
+
+void shmem_stage_put(void *dst, const void *val, const size_t size,
+                     const int pe) {
+  SHMEMStagingBuffer &buffer = thread_staging_buffer();
+  if (buffer.used != 0 && released_ticket.load() > buffer.ticket)
+    buffer.used = 0;
+
+  if (buffer.used + size > buffer.capacity) {
+    /* Complete the puts of this PE so that the buffer can be reused */
+    if (buffer.used != 0) shmem_quiet();
+    buffer.used = 0;
+
+    const size_t required = std::max(SHMEMSpace::nonblocking_chunk_size, size);
+    if (buffer.capacity < required) {
+      buffer.data.reset(new char[required]);
+      buffer.capacity = required;
+    }
+  }
+
+  char *src = buffer.data.get() + buffer.used;
+  std::memcpy(src, val, size);
+  shmem_putmem_nbi(dst, src, size, pe);
+  buffer.used += size;
+  buffer.ticket = release_tickets.load();
+}
+
+uint64_t shmem_begin_staged_release() { return ++release_tickets; }
+
+void shmem_end_staged_release(const uint64_t ticket) {
+  uint64_t released = released_ticket.load();
+  while (released < ticket &&
+         !released_ticket.compare_exchange_weak(released, ticket)) {
+  }
+}
+
+}  // namespace Impl
+}  // namespace Kokkos
@@ -1,4 +1,6 @@
 #include <shmem.h>
+#include <atomic>
+#include <cstdint>
 #include <type_traits>
 //----------------------------------------------------------------------------
 /** \brief  View mapping for non-specialized data type and standard layout */
@@ -6,728 +8,488 @@
 namespace Kokkos {
 namespace Impl {
 
-KOKKOS_INLINE_FUNCTION
-void shmem_type_p(int* ptr, const int& val, const int pe) {
-#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST
-  shmem_int_p(ptr, val, pe);
-#endif
-}
+#define KOKKOS_IMPL_SHMEM_TYPE_PG(T, NAME)                          \
+  KOKKOS_INLINE_FUNCTION                                            \
+  void shmem_type_p(T* ptr, const T& val, const int pe) {           \
+    shmem_##NAME##_p(ptr, val, pe);                                 \
+  }                                                                 \
+                                                                    \
+  KOKKOS_INLINE_FUNCTION                                            \
+  T shmem_type_g(T* ptr, const int pe) { return shmem_##NAME##_g(ptr, pe); }
 
-KOKKOS_INLINE_FUNCTION
-int shmem_type_g(int* ptr, const int pe) {
-#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST
-  return shmem_int_g(ptr, pe);
-#else
-  return 0;
-#endif
-}
+KOKKOS_IMPL_SHMEM_TYPE_PG(int, int)
+KOKKOS_IMPL_SHMEM_TYPE_PG(long, long)
+KOKKOS_IMPL_SHMEM_TYPE_PG(long long, longlong)
+KOKKOS_IMPL_SHMEM_TYPE_PG(float, float)
+KOKKOS_IMPL_SHMEM_TYPE_PG(double, double)
 
-KOKKOS_INLINE_FUNCTION
-void shmem_type_p(double* ptr, const double& val, const int pe) {
-#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST
-  shmem_double_p(ptr, val, pe);
-#endif
-}
+#undef KOKKOS_IMPL_SHMEM_TYPE_PG
 
-KOKKOS_INLINE_FUNCTION
-double shmem_type_g(double* ptr, const int pe) {
-#ifdef KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST
-  return shmem_double_g(ptr, pe);
-#else
-  return 0;
-#endif
+// Types without a single-element routine are moved as bytes
+template <class T>
+KOKKOS_INLINE_FUNCTION void shmem_type_p(T* ptr, const T& val, const int pe) {
+  shmem_putmem(ptr, &val, sizeof(T), pe);
 }
 
-struct SHMEMSpaceSpecializeTag {};
-
 template <class T>
-struct SHMEMDataElement {
-  typedef const T const_value_type;
-  typedef T non_const_value_type;
-  T* ptr;
-  int pe;
-  SHMEMDataElement(T* ptr_, int pe_, int i_) : ptr(ptr_ + i_), pe(pe_) {}
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator=(const_value_type& val) const {
-    shmem_type_p(ptr, val, pe);
-    return val;
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  void inc() const {
-    T val = shmem_type_g(ptr, pe);
-    val++;
-    shmem_type_p(ptr, val, pe);
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  void dec() const {
-    T val = shmem_type_g(ptr, pe);
-    val--;
-    shmem_type_p(ptr, val, pe);
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator++() const {
-    T val = shmem_type_g(ptr, pe);
-    val++;
-    shmem_type_p(ptr, val, pe);
-    return val;
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator--() const {
-    T val = shmem_type_g(ptr, pe);
-    val--;
-    shmem_type_p(ptr, val, pe);
-    return val;
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator++(int) const {
-    T val = shmem_type_g(ptr, pe);
-    val++;
-    shmem_type_p(ptr, val, pe);
-    return val;
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator--(int) const {
-    T val = shmem_type_g(ptr, pe);
-    val--;
-    shmem_type_p(ptr, val, pe);
-    return val;
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator+=(const_value_type& val) const {
-    T tmp = shmem_type_g(ptr, pe);
-    tmp += val;
-    shmem_type_p(ptr, tmp, pe);
-    return tmp;
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator-=(const_value_type& val) const {
-    T tmp = shmem_type_g(ptr, pe);
-    tmp -= val;
-    shmem_type_p(ptr, tmp, pe);
-    return tmp;
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator*=(const_value_type& val) const {
-    T tmp = shmem_type_g(ptr, pe);
-    tmp *= val;
-    shmem_type_p(ptr, tmp, pe);
-    return tmp;
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator/=(const_value_type& val) const {
-    T tmp = shmem_type_g(ptr, pe);
-    tmp /= val;
-    shmem_type_p(ptr, tmp, pe);
-    return tmp;
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator%=(const_value_type& val) const {
-    T tmp = shmem_type_g(ptr, pe);
-    tmp %= val;
-    shmem_type_p(ptr, tmp, pe);
-    return tmp;
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator&=(const_value_type& val) const {
-    T tmp = shmem_type_g(ptr, pe);
-    tmp &= val;
-    shmem_type_p(ptr, tmp, pe);
-    return tmp;
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator^=(const_value_type& val) const {
-    T tmp = shmem_type_g(ptr, pe);
-    tmp ^= val;
-    shmem_type_p(ptr, tmp, pe);
-    return tmp;
-  }
+KOKKOS_INLINE_FUNCTION T shmem_type_g(T* ptr, const int pe) {
+  T val;
+  shmem_getmem(&val, ptr, sizeof(T), pe);
+  return val;
+}
 
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator|=(const_value_type& val) const {
-    T tmp = shmem_type_g(ptr, pe);
-    tmp |= val;
-    shmem_type_p(ptr, tmp, pe);
-    return tmp;
-  }
+/* Atomic memory operations.  OpenSHMEM 1.4 provides bitwise AMOs only for
+ * unsigned types, so every AMO is issued on the unsigned type of the same
+ * width, which gives the same bits for signed integers.  Operations without
+ * an AMO and floating point types use a compare-and-swap loop on the bits
+ * of the element.  Atomicity only holds with respect to other AMOs. */
+
+#define KOKKOS_IMPL_SHMEM_AMO_TYPE(T, NAME)                            \
+  inline T shmem_amo_fetch(T* ptr, const int pe) {                     \
+    return shmem_##NAME##_atomic_fetch(ptr, pe);                       \
+  }                                                                    \
+                                                                       \
+  inline T shmem_amo_compare_swap(T* ptr, const T& cond, const T& val, \
+                                  const int pe) {                      \
+    return shmem_##NAME##_atomic_compare_swap(ptr, cond, val, pe);     \
+  }                                                                    \
+                                                                       \
+  inline T shmem_amo_fetch_op(RemoteSumOp, T* ptr, const T& val,       \
+                              const int pe) {                          \
+    return shmem_##NAME##_atomic_fetch_add(ptr, val, pe);              \
+  }                                                                    \
+                                                                       \
+  inline T shmem_amo_fetch_op(RemoteBandOp, T* ptr, const T& val,      \
+                              const int pe) {                          \
+    return shmem_##NAME##_atomic_fetch_and(ptr, val, pe);              \
+  }                                                                    \
+                                                                       \
+  inline T shmem_amo_fetch_op(RemoteBorOp, T* ptr, const T& val,       \
+                              const int pe) {                          \
+    return shmem_##NAME##_atomic_fetch_or(ptr, val, pe);               \
+  }                                                                    \
+                                                                       \
+  inline T shmem_amo_fetch_op(RemoteBxorOp, T* ptr, const T& val,      \
+                              const int pe) {                          \
+    return shmem_##NAME##_atomic_fetch_xor(ptr, val, pe);              \
+  }                                                                    \
+                                                                       \
+  inline void shmem_amo_atomic_op(RemoteSumOp, T* ptr, const T& val,   \
+                                  const int pe) {                      \
+    shmem_##NAME##_atomic_add(ptr, val, pe);                           \
+  }                                                                    \
+                                                                       \
+  inline void shmem_amo_atomic_op(RemoteBandOp, T* ptr, const T& val,  \
+                                  const int pe) {                      \
+    shmem_##NAME##_atomic_and(ptr, val, pe);                           \
+  }                                                                    \
+                                                                       \
+  inline void shmem_amo_atomic_op(RemoteBorOp, T* ptr, const T& val,   \
+                                  const int pe) {                      \
+    shmem_##NAME##_atomic_or(ptr, val, pe);                            \
+  }                                                                    \
+                                                                       \
+  inline void shmem_amo_atomic_op(RemoteBxorOp, T* ptr, const T& val,  \
+                                  const int pe) {                      \
+    shmem_##NAME##_atomic_xor(ptr, val, pe);                           \
+  }
+
+KOKKOS_IMPL_SHMEM_AMO_TYPE(unsigned int, uint)
+KOKKOS_IMPL_SHMEM_AMO_TYPE(unsigned long, ulong)
+KOKKOS_IMPL_SHMEM_AMO_TYPE(unsigned long long, ulonglong)
+
+#undef KOKKOS_IMPL_SHMEM_AMO_TYPE
+
+/* Unsigned type of the width of T for the types with atomic operations */
+template <class T>
+struct SHMEMAtomicType {
+  enum { value = false };
+};
 
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator<<=(const_value_type& val) const {
-    T tmp = shmem_type_g(ptr, pe);
-    tmp <<= val;
-    shmem_type_p(ptr, tmp, pe);
-    return tmp;
+#define KOKKOS_IMPL_SHMEM_ATOMIC_TYPE(T, BITS) \
+  template <>                                  \
+  struct SHMEMAtomicType<T> {                  \
+    enum { value = true };                     \
+    typedef BITS bits_type;                    \
+  };
+
+KOKKOS_IMPL_SHMEM_ATOMIC_TYPE(int, unsigned int)
+KOKKOS_IMPL_SHMEM_ATOMIC_TYPE(long, unsigned long)
+KOKKOS_IMPL_SHMEM_ATOMIC_TYPE(long long, unsigned long long)
+KOKKOS_IMPL_SHMEM_ATOMIC_TYPE(unsigned int, unsigned int)
+KOKKOS_IMPL_SHMEM_ATOMIC_TYPE(unsigned long, unsigned long)
+KOKKOS_IMPL_SHMEM_ATOMIC_TYPE(unsigned long long, unsigned long long)
+KOKKOS_IMPL_SHMEM_ATOMIC_TYPE(float, unsigned int)
+KOKKOS_IMPL_SHMEM_ATOMIC_TYPE(double, unsigned long long)
+
+#undef KOKKOS_IMPL_SHMEM_ATOMIC_TYPE
+
+template <class Op, class T>
+T shmem_type_fetch_op(Op, T* ptr, const T& val, const int pe) {
+  typedef typename SHMEMAtomicType<T>::bits_type B;
+  static_assert(sizeof(B) == sizeof(T), "SHMEM atomic type size mismatch");
+  B* target  = reinterpret_cast<B*>(ptr);
+  B expected = shmem_amo_fetch(target, pe);
+  while (true) {
+    T prev;
+    memcpy(&prev, &expected, sizeof(T));
+    const T next = Op::apply(prev, val);
+    B desired;
+    memcpy(&desired, &next, sizeof(T));
+    const B found = shmem_amo_compare_swap(target, expected, desired, pe);
+    if (found == expected) return prev;
+    expected = found;
   }
+}
 
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator>>=(const_value_type& val) const {
-    T tmp = shmem_type_g(ptr, pe);
-    tmp >>= val;
-    shmem_type_p(ptr, tmp, pe);
-    return tmp;
-  }
+#define KOKKOS_IMPL_SHMEM_NATIVE_AMO(OP)                                    \
+  template <class T>                                                        \
+  typename std::enable_if<std::is_integral<T>::value, T>::type              \
+  shmem_type_fetch_op(OP, T* ptr, const T& val, const int pe) {             \
+    typedef typename SHMEMAtomicType<T>::bits_type B;                       \
+    return T(shmem_amo_fetch_op(OP(), reinterpret_cast<B*>(ptr), B(val),    \
+                                pe));                                       \
+  }                                                                         \
+                                                                            \
+  template <class T>                                                        \
+  typename std::enable_if<std::is_integral<T>::value>::type                 \
+  shmem_type_atomic_op(OP, T* ptr, const T& val, const int pe) {            \
+    typedef typename SHMEMAtomicType<T>::bits_type B;                       \
+    shmem_amo_atomic_op(OP(), reinterpret_cast<B*>(ptr), B(val), pe);       \
+  }
+
+KOKKOS_IMPL_SHMEM_NATIVE_AMO(RemoteSumOp)
+KOKKOS_IMPL_SHMEM_NATIVE_AMO(RemoteBandOp)
+KOKKOS_IMPL_SHMEM_NATIVE_AMO(RemoteBorOp)
+KOKKOS_IMPL_SHMEM_NATIVE_AMO(RemoteBxorOp)
+
+#undef KOKKOS_IMPL_SHMEM_NATIVE_AMO
+
+template <class Op, class T>
+void shmem_type_atomic_op(Op, T* ptr, const T& val, const int pe) {
+  shmem_type_fetch_op(Op(), ptr, val, pe);
+}
 
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator+(const_value_type& val) const {
-    T tmp = shmem_type_g(ptr, pe);
-    return tmp + val;
-  }
+template <class T>
+struct SHMEMDataHandle;
 
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator-(const_value_type& val) const {
-    T tmp = shmem_type_g(ptr, pe);
-    return tmp - val;
-  }
+/** \brief  Backend traits of SHMEMSpace.
+ *
+ *  Elements are addressed by their symmetric address and rank.  Ranks of
+ *  views allocated over a team are translated to world PEs through a table
+ *  built at allocation.  Elements of PEs that shmem_ptr can reach are
+ *  accessed with loads and stores.
+ *  Read-modify-write operations on integer and floating point elements are
+ *  atomic memory operations, on other types a get and a put.
+ */
+struct SHMEMBackend {
+  typedef Kokkos::SHMEMSpace memory_space;
+  typedef Kokkos::HostSpace local_memory_space;
 
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator*(const_value_type& val) const {
-    T tmp = shmem_type_g(ptr, pe);
-    return tmp * val;
-  }
+  template <class T>
+  using handle = SHMEMDataHandle<T>;
 
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator/(const_value_type& val) const {
-    T tmp = shmem_type_g(ptr, pe);
-    return tmp / val;
-  }
+  template <class T>
+  struct address {
+    T* ptr;
+    int pe;
+    // Address of the element if it is directly addressable, NULL otherwise
+    T* local;
+  };
 
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator%(const_value_type& val) const {
-    T tmp = shmem_type_g(ptr, pe);
-    return tmp % val;
-  }
+  template <class T, class Op>
+  struct has_fetch_op
+      : std::integral_constant<bool, SHMEMAtomicType<T>::value> {};
 
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator!() const {
-    T tmp = shmem_type_g(ptr, pe);
-    return !tmp;
-  }
+  static int num_pes(const memory_space& space) { return space.num_pes(); }
 
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator&&(const_value_type& val) const {
-    T tmp = shmem_type_g(ptr, pe);
-    return tmp && val;
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator||(const_value_type& val) const {
-    T tmp = shmem_type_g(ptr, pe);
-    return tmp || val;
+  template <class T>
+  KOKKOS_INLINE_FUNCTION static SHMEMDataHandle<T> make_handle(T* ptr) {
+    return SHMEMDataHandle<T>(ptr);
   }
 
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator&(const_value_type& val) const {
-    T tmp = shmem_type_g(ptr, pe);
-    return tmp & val;
+  template <class T, class Record>
+  KOKKOS_INLINE_FUNCTION static SHMEMDataHandle<T> make_handle(
+      T* ptr, const Record* record) {
+    return SHMEMDataHandle<T>(
+        ptr, record->peer_ptrs.empty() ? NULL : record->peer_ptrs.data(),
+        ptr - static_cast<T*>(record->data()),
+        record->team_pes.empty() ? NULL : record->team_pes.data(),
+        &record->m_space);
   }
 
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator|(const_value_type& val) const {
-    T tmp = shmem_type_g(ptr, pe);
-    return tmp | val;
+  template <class Record>
+  static const int64_t* partition_offsets(const Record* record) {
+    return record->partition_offsets.empty()
+               ? NULL
+               : record->partition_offsets.data();
   }
 
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator^(const_value_type& val) const {
-    T tmp = shmem_type_g(ptr, pe);
-    return tmp ^ val;
+  template <class T>
+  KOKKOS_INLINE_FUNCTION static SHMEMDataHandle<T> shift(
+      const SHMEMDataHandle<T>& arg_handle, const size_t offset) {
+    SHMEMDataHandle<T> handle(arg_handle);
+    handle.ptr += offset;
+    handle.peer_offset += offset;
+    return handle;
   }
 
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator~() const {
-    T tmp = shmem_type_g(ptr, pe);
-    return ~tmp;
+  template <class T>
+  static int my_pe(const SHMEMDataHandle<T>& handle) {
+    return handle.space ? handle.space->my_pe() : shmem_my_pe();
   }
 
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator<<(const unsigned int& val) const {
-    T tmp = shmem_type_g(ptr, pe);
-    return tmp << val;
+  template <class T>
+  KOKKOS_INLINE_FUNCTION static T* direct(const address<T>& addr) {
+    return addr.local;
   }
 
-  KOKKOS_INLINE_FUNCTION
-  const_value_type operator>>(const unsigned int& val) const {
-    T tmp = shmem_type_g(ptr, pe);
-    return tmp >> val;
+  template <class T>
+  KOKKOS_INLINE_FUNCTION static T get(const address<T>& addr) {
+    return shmem_type_g(addr.ptr, addr.pe);
   }
 
-  KOKKOS_INLINE_FUNCTION
-  bool operator==(const_value_type& val) const {
-    T tmp = shmem_type_g(ptr, pe);
-    return tmp == val;
+  template <class T>
+  KOKKOS_INLINE_FUNCTION static void put(const address<T>& addr,
+                                         const T& val) {
+    if (SHMEMSpace::nonblocking_puts)
+      shmem_stage_put(addr.ptr, &val, sizeof(T), addr.pe);
+    else
+      shmem_type_p(addr.ptr, val, addr.pe);
   }
 
-  KOKKOS_INLINE_FUNCTION
-  bool operator!=(const_value_type& val) const {
-    T tmp = shmem_type_g(ptr, pe);
-    return tmp != val;
+  // Completed by SHMEMSpace::wait_all()
+  template <class T>
+  KOKKOS_INLINE_FUNCTION static void get_async(const address<T>& addr,
+                                               T& val) {
+    shmem_getmem_nbi(&val, addr.ptr, sizeof(T), addr.pe);
   }
 
-  KOKKOS_INLINE_FUNCTION
-  bool operator>=(const_value_type& val) const {
-    T tmp = shmem_type_g(ptr, pe);
-    return tmp >= val;
+  template <class Op, class T>
+  KOKKOS_INLINE_FUNCTION static T fetch_op(const address<T>& addr,
+                                           const T& val) {
+    return shmem_type_fetch_op(Op(), addr.ptr, val, addr.pe);
   }
 
-  KOKKOS_INLINE_FUNCTION
-  bool operator<=(const_value_type& val) const {
-    T tmp = shmem_type_g(ptr, pe);
-    return tmp <= val;
+  template <class Op, class T>
+  KOKKOS_INLINE_FUNCTION static void atomic_op(const address<T>& addr,
+                                               const T& val) {
+    shmem_type_atomic_op(Op(), addr.ptr, val, addr.pe);
   }
 
-  KOKKOS_INLINE_FUNCTION
-  bool operator<(const_value_type& val) const {
-    T tmp = shmem_type_g(ptr, pe);
-    return tmp < val;
+  // OpenSHMEM completes operations per PE, not per symmetric object.  The
+  // fence of a view is the collective fence of its space and completes
+  // the operations on all views.
+  template <class T>
+  static void fence(const SHMEMDataHandle<T>& handle) {
+    SHMEMSpace space = handle.space ? *handle.space : SHMEMSpace();
+    space.fence();
   }
+};
 
-  KOKKOS_INLINE_FUNCTION
-  bool operator>(const_value_type& val) const {
-    T tmp = shmem_type_g(ptr, pe);
-    return tmp > val;
-  }
+typedef RemoteSpaceSpecializeTag<SHMEMBackend> SHMEMSpaceSpecializeTag;
 
-  KOKKOS_INLINE_FUNCTION
-  operator const_value_type() const { return shmem_type_g(ptr, pe); }
-};
+template <class T>
+using SHMEMDataElement = RemoteDataElement<SHMEMBackend, T>;
 
 template <class T>
 struct SHMEMDataHandle {
   T* ptr;
-  KOKKOS_INLINE_FUNCTION
-  SHMEMDataHandle() : ptr(NULL) {}
-  KOKKOS_INLINE_FUNCTION
-  SHMEMDataHandle(T* ptr_) : ptr(ptr_) {}
+  // Partitions of the PEs reachable through shmem_ptr, indexed by PE, and
+  // the offset of a subview into them
+  void* const* peers;
+  size_t peer_offset;
+  // World PE of every PE of the team of the allocation, NULL for all PEs
+  const int* pes;
+  const SHMEMSpace* space;
+  KOKKOS_INLINE_FUNCTION
+  SHMEMDataHandle()
+      : ptr(NULL), peers(NULL), peer_offset(0), pes(NULL), space(NULL) {}
+  KOKKOS_INLINE_FUNCTION
+  SHMEMDataHandle(T* ptr_, void* const* peers_ = NULL,
+                  const size_t peer_offset_ = 0, const int* pes_ = NULL,
+                  const SHMEMSpace* space_ = NULL)
+      : ptr(ptr_),
+        peers(peers_),
+        peer_offset(peer_offset_),
+        pes(pes_),
+        space(space_) {}
+  KOKKOS_INLINE_FUNCTION
+  int world_pe(const int pe) const { return pes ? pes[pe] : pe; }
   template <typename iType>
   KOKKOS_INLINE_FUNCTION SHMEMDataElement<T> operator()(const int& pe,
                                                         const iType& i) const {
-    SHMEMDataElement<T> element(ptr, pe, i);
-    return element;
-  }
-};
-
-template <>
-struct SHMEMDataHandle<int> {
-  int* ptr;
-  KOKKOS_INLINE_FUNCTION
-  SHMEMDataHandle() : ptr(NULL) {}
-  KOKKOS_INLINE_FUNCTION
-  SHMEMDataHandle(int* ptr_) : ptr(ptr_) {}
-  template <typename iType>
-  KOKKOS_INLINE_FUNCTION SHMEMDataElement<int> operator()(
-      const int& pe, const iType& i) const {
-    SHMEMDataElement<int> element(ptr, pe, i);
-    return element;
-  }
-};
-
-template <class Traits>
-struct ViewDataHandle<
-    Traits,
-    typename std::enable_if<std::is_same<
-        typename Traits::specialize, SHMEMSpaceSpecializeTag>::value>::type> {
-  typedef typename Traits::value_type value_type;
-  typedef SHMEMDataHandle<value_type> handle_type;
-  typedef SHMEMDataElement<value_type> return_type;
-  typedef Kokkos::Impl::SharedAllocationTracker track_type;
-
-  KOKKOS_INLINE_FUNCTION
-  static handle_type assign(value_type* arg_data_ptr,
-                            track_type const& /*arg_tracker*/) {
-    return handle_type(arg_data_ptr);
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  static handle_type assign(handle_type const arg_data_ptr, size_t offset) {
-    return handle_type(arg_data_ptr + offset);
+    T* local = NULL;
+    if (peers && peers[pe])
+      local = static_cast<T*>(peers[pe]) + peer_offset + i;
+    const typename SHMEMBackend::address<T> addr = {ptr + i, world_pe(pe),
+                                                    local};
+    return SHMEMDataElement<T>(addr);
   }
 };
 
 }  // namespace Impl
 
 template <class... Prop>
-struct ViewTraits<void, SHMEMSpace, Prop...> {
-  // Specify Space, memory traits should be the only subsequent argument.
-
-  static_assert(
-      std::is_same<typename ViewTraits<void, Prop...>::execution_space,
-                   void>::value &&
-          std::is_same<typename ViewTraits<void, Prop...>::memory_space,
-                       void>::value &&
-          std::is_same<typename ViewTraits<void, Prop...>::HostMirrorSpace,
-                       void>::value &&
-          std::is_same<typename ViewTraits<void, Prop...>::array_layout,
-                       void>::value,
-      "Only one View Execution or Memory Space template argument");
-
-  typedef typename SHMEMSpace::execution_space execution_space;
-  typedef typename SHMEMSpace::memory_space memory_space;
-  typedef typename Kokkos::Impl::HostMirror<SHMEMSpace>::Space HostMirrorSpace;
-  typedef typename execution_space::array_layout array_layout;
-  typedef typename ViewTraits<void, Prop...>::memory_traits memory_traits;
-  typedef typename Impl::SHMEMSpaceSpecializeTag specialize;
-};
+struct ViewTraits<void, SHMEMSpace, Prop...>
+    : Impl::RemoteSpaceViewTraits<SHMEMSpace, Impl::SHMEMSpaceSpecializeTag,
+                                  Prop...> {};
 
 namespace Impl {
 
-template <class Traits>
-class ViewMapping<Traits, SHMEMSpaceSpecializeTag> {
- private:
-  template <class, class...>
-  friend class ViewMapping;
-  template <class, class...>
-  friend class Kokkos::View;
-
-  typedef ViewOffset<typename Traits::dimension, typename Traits::array_layout,
-                     void>
-      offset_type;
-
-  typedef typename ViewDataHandle<Traits>::handle_type handle_type;
-
-  handle_type m_handle;
-  offset_type m_offset;
-  int m_num_pes;
-
-  KOKKOS_INLINE_FUNCTION
-  ViewMapping(const handle_type& arg_handle, const offset_type& arg_offset)
-      : m_handle(arg_handle), m_offset(arg_offset) {}
-
- public:
-  typedef void printable_label_typedef;
-  enum { is_managed = Traits::is_managed };
-
-  //----------------------------------------
-  // Domain dimensions
-
-  enum { Rank = Traits::dimension::rank };
-
-  template <typename iType>
-  KOKKOS_INLINE_FUNCTION constexpr size_t extent(const iType& r) const {
-    return m_offset.m_dim.extent(r);
-  }
-
-  KOKKOS_INLINE_FUNCTION constexpr typename Traits::array_layout layout()
-      const {
-    return m_offset.layout();
-  }
-
-  KOKKOS_INLINE_FUNCTION constexpr size_t dimension_0() const {
-    return m_num_pes;
-  }
-  KOKKOS_INLINE_FUNCTION constexpr size_t dimension_1() const {
-    return m_offset.dimension_1();
-  }
-  KOKKOS_INLINE_FUNCTION constexpr size_t dimension_2() const {
-    return m_offset.dimension_2();
-  }
-  KOKKOS_INLINE_FUNCTION constexpr size_t dimension_3() const {
-    return m_offset.dimension_3();
-  }
-  KOKKOS_INLINE_FUNCTION constexpr size_t dimension_4() const {
-    return m_offset.dimension_4();
-  }
-  KOKKOS_INLINE_FUNCTION constexpr size_t dimension_5() const {
-    return m_offset.dimension_5();
-  }
-  KOKKOS_INLINE_FUNCTION constexpr size_t dimension_6() const {
-    return m_offset.dimension_6();
-  }
-  KOKKOS_INLINE_FUNCTION constexpr size_t dimension_7() const {
-    return m_offset.dimension_7();
-  }
-
-  // Is a regular layout with uniform striding for each index.
-  using is_regular = typename offset_type::is_regular;
-
-  KOKKOS_INLINE_FUNCTION constexpr size_t stride_0() const {
-    return m_offset.stride_0();
-  }
-  KOKKOS_INLINE_FUNCTION constexpr size_t stride_1() const {
-    return m_offset.stride_1();
-  }
-  KOKKOS_INLINE_FUNCTION constexpr size_t stride_2() const {
-    return m_offset.stride_2();
-  }
-  KOKKOS_INLINE_FUNCTION constexpr size_t stride_3() const {
-    return m_offset.stride_3();
-  }
-  KOKKOS_INLINE_FUNCTION constexpr size_t stride_4() const {
-    return m_offset.stride_4();
-  }
-  KOKKOS_INLINE_FUNCTION constexpr size_t stride_5() const {
-    return m_offset.stride_5();
-  }
-  KOKKOS_INLINE_FUNCTION constexpr size_t stride_6() const {
-    return m_offset.stride_6();
-  }
-  KOKKOS_INLINE_FUNCTION constexpr size_t stride_7() const {
-    return m_offset.stride_7();
-  }
-
-  template <typename iType>
-  KOKKOS_INLINE_FUNCTION void stride(iType* const s) const {
-    m_offset.stride(s);
-  }
-
-  //----------------------------------------
-  // Range span
-
-  /** \brief  Span of the mapped range */
-  KOKKOS_INLINE_FUNCTION constexpr size_t span() const {
-    return m_offset.span();
-  }
-
-  /** \brief  Is the mapped range span contiguous */
-  KOKKOS_INLINE_FUNCTION constexpr bool span_is_contiguous() const {
-    return m_offset.span_is_contiguous();
-  }
-
-  typedef typename ViewDataHandle<Traits>::return_type reference_type;
-  typedef typename Traits::value_type* pointer_type;
-
-  /** \brief  Query raw pointer to memory */
-  KOKKOS_INLINE_FUNCTION constexpr pointer_type data() const {
-    return m_handle.ptr;
-  }
-
-  //----------------------------------------
-  // The View class performs all rank and bounds checking before
-  // calling these element reference methods.
-
-  KOKKOS_FORCEINLINE_FUNCTION
-  reference_type reference() const { return m_handle[0]; }
-
-  template <typename I0>
-  KOKKOS_FORCEINLINE_FUNCTION
-      typename std::enable_if<std::is_integral<I0>::value &&
-                                  !std::is_same<typename Traits::array_layout,
-                                                Kokkos::LayoutStride>::value,
-                              reference_type>::type
-      reference(const I0& i0) const {
-    return m_handle(i0, 0);
-  }
-
-  template <typename I0>
-  KOKKOS_FORCEINLINE_FUNCTION
-      typename std::enable_if<std::is_integral<I0>::value &&
-                                  std::is_same<typename Traits::array_layout,
-                                               Kokkos::LayoutStride>::value,
-                              reference_type>::type
-      reference(const I0& i0) const {
-    return m_handle(i0, 0);
-  }
-
-  template <typename I0, typename I1>
-  KOKKOS_FORCEINLINE_FUNCTION const reference_type
-  reference(const I0& i0, const I1& i1) const {
-    const reference_type element = m_handle(i0, m_offset(0, i1));
-    return element;
-  }
-
-  template <typename I0, typename I1, typename I2>
-  KOKKOS_FORCEINLINE_FUNCTION reference_type reference(const I0& i0,
-                                                       const I1& i1,
-                                                       const I2& i2) const {
-    return m_handle(i0, m_offset(0, i1, i2));
-  }
-
-  template <typename I0, typename I1, typename I2, typename I3>
-  KOKKOS_FORCEINLINE_FUNCTION reference_type
-  reference(const I0& i0, const I1& i1, const I2& i2, const I3& i3) const {
-    return m_handle(i0, m_offset(0, i1, i2, i3));
-  }
-
-  template <typename I0, typename I1, typename I2, typename I3, typename I4>
-  KOKKOS_FORCEINLINE_FUNCTION reference_type reference(const I0& i0,
-                                                       const I1& i1,
-                                                       const I2& i2,
-                                                       const I3& i3,
-                                                       const I4& i4) const {
-    return m_handle(i0, m_offset(0, i1, i2, i3, i4));
-  }
-
-  template <typename I0, typename I1, typename I2, typename I3, typename I4,
-            typename I5>
-  KOKKOS_FORCEINLINE_FUNCTION reference_type
-  reference(const I0& i0, const I1& i1, const I2& i2, const I3& i3,
-            const I4& i4, const I5& i5) const {
-    return m_handle(i0, m_offset(0, i1, i2, i3, i4, i5));
-  }
-
-  template <typename I0, typename I1, typename I2, typename I3, typename I4,
-            typename I5, typename I6>
-  KOKKOS_FORCEINLINE_FUNCTION reference_type
-  reference(const I0& i0, const I1& i1, const I2& i2, const I3& i3,
-            const I4& i4, const I5& i5, const I6& i6) const {
-    return m_handle(i0, m_offset(0, i1, i2, i3, i4, i5, i6));
-  }
-
-  template <typename I0, typename I1, typename I2, typename I3, typename I4,
-            typename I5, typename I6, typename I7>
-  KOKKOS_FORCEINLINE_FUNCTION reference_type
-  reference(const I0& i0, const I1& i1, const I2& i2, const I3& i3,
-            const I4& i4, const I5& i5, const I6& i6, const I7& i7) const {
-    return m_handle(i0, m_offset(0, i1, i2, i3, i4, i5, i6, i7));
-  }
-
-  //----------------------------------------
-
- private:
-  enum { MemorySpanMask = 8 - 1 /* Force alignment on 8 byte boundary */ };
-  enum { MemorySpanSize = sizeof(typename Traits::value_type) };
-
- public:
-  /** \brief  Span, in bytes, of the referenced memory */
-  KOKKOS_INLINE_FUNCTION constexpr size_t memory_span() const {
-    return (m_offset.span() * sizeof(typename Traits::value_type) +
-            MemorySpanMask) &
-           ~size_t(MemorySpanMask);
-  }
-
-  //----------------------------------------
-
-  KOKKOS_INLINE_FUNCTION ~ViewMapping() {}
-  KOKKOS_INLINE_FUNCTION ViewMapping() : m_handle(), m_offset(), m_num_pes(0) {}
-  KOKKOS_INLINE_FUNCTION ViewMapping(const ViewMapping& rhs)
-      : m_handle(rhs.m_handle),
-        m_offset(rhs.m_offset),
-        m_num_pes(rhs.m_num_pes) {}
-  KOKKOS_INLINE_FUNCTION ViewMapping& operator=(const ViewMapping& rhs) {
-    m_handle  = rhs.m_handle;
-    m_offset  = rhs.m_offset;
-    m_num_pes = rhs.m_num_pes;
-    return *this;
-  }
-
-  KOKKOS_INLINE_FUNCTION ViewMapping(ViewMapping&& rhs)
-      : m_handle(rhs.m_handle),
-        m_offset(rhs.m_offset),
-        m_num_pes(rhs.m_num_pes) {}
-  KOKKOS_INLINE_FUNCTION ViewMapping& operator=(ViewMapping&& rhs) {
-    m_handle  = rhs.m_handle;
-    m_offset  = rhs.m_offset;
-    m_num_pes = rhs.m_num_pes;
-    return *this;
-  }
-
-  //----------------------------------------
-
-  /**\brief  Span, in bytes, of the required memory */
-  KOKKOS_INLINE_FUNCTION
-  static constexpr size_t memory_span(
-      typename Traits::array_layout const& arg_layout) {
-    typedef std::integral_constant<unsigned, 0> padding;
-    return (offset_type(padding(), arg_layout).span() * MemorySpanSize +
-            MemorySpanMask) &
-           ~size_t(MemorySpanMask);
-  }
-
-  /**\brief  Wrap a span of memory */
-  template <class... P>
-  KOKKOS_INLINE_FUNCTION ViewMapping(
-      Kokkos::Impl::ViewCtorProp<P...> const& arg_prop,
-      typename Traits::array_layout const& arg_layout)
-      : m_handle(
-            ((Kokkos::Impl::ViewCtorProp<void, pointer_type> const&)arg_prop)
-                .value) {
-    typedef typename Traits::value_type value_type;
-    typedef std::integral_constant<
-        unsigned, Kokkos::Impl::ViewCtorProp<P...>::allow_padding
-                      ? sizeof(value_type)
-                      : 0>
-        padding;
-
-    typename Traits::array_layout layout;
-    for (int i = 0; i < Traits::rank; i++)
-      layout.dimension[i] = arg_layout.dimension[i];
-    layout.dimension[0] = 1;
-    m_offset            = offset_type(padding(), layout);
-    m_num_pes           = shmem_n_pes();
-  }
-
-  /**\brief  Assign data */
-  KOKKOS_INLINE_FUNCTION
-  void assign_data(pointer_type arg_ptr) { m_handle = handle_type(arg_ptr); }
-
-  //----------------------------------------
-  /*  Allocate and construct mapped array.
-   *  Allocate via shared allocation record and
-   *  return that record for allocation tracking.
-   */
-  template <class... P>
-  Kokkos::Impl::SharedAllocationRecord<>* allocate_shared(
-      Kokkos::Impl::ViewCtorProp<P...> const& arg_prop,
-      typename Traits::array_layout const& arg_layout) {
-    typedef Kokkos::Impl::ViewCtorProp<P...> alloc_prop;
-
-    typedef typename alloc_prop::execution_space execution_space;
-    typedef typename Traits::memory_space memory_space;
-    typedef typename Traits::value_type value_type;
-    typedef ViewValueFunctor<execution_space, value_type> functor_type;
-    typedef Kokkos::Impl::SharedAllocationRecord<memory_space, functor_type>
-        record_type;
-
-    // Query the mapping for byte-size of allocation.
-    // If padding is allowed then pass in sizeof value type
-    // for padding computation.
-    typedef std::integral_constant<
-        unsigned, alloc_prop::allow_padding ? sizeof(value_type) : 0>
-        padding;
-
-    typename Traits::array_layout layout;
-    for (int i = 0; i < Traits::rank; i++)
-      layout.dimension[i] = arg_layout.dimension[i];
-    layout.dimension[0] = 1;
-    m_offset            = offset_type(padding(), layout);
-    m_num_pes           = shmem_n_pes();
-
-    const size_t alloc_size =
-        (m_offset.span() * MemorySpanSize + MemorySpanMask) &
-        ~size_t(MemorySpanMask);
-
-    // Create shared memory tracking record with allocate memory from the memory
-    // space
-    record_type* const record = record_type::allocate(
-        ((Kokkos::Impl::ViewCtorProp<void, memory_space> const&)arg_prop).value,
-        ((Kokkos::Impl::ViewCtorProp<void, std::string> const&)arg_prop).value,
-        alloc_size);
-
-#ifdef KOKKOS_ENABLE_DEPRECATED_CODE
-    if (alloc_size) {
-#endif
-      m_handle = handle_type(reinterpret_cast<pointer_type>(record->data()));
-#ifdef KOKKOS_ENABLE_DEPRECATED_CODE
+/* Contiguous ranges are moved with one shmem_getmem or shmem_putmem, or
+ * copied directly if the partition is addressable.  Gets complete on
+ * return, puts at the next fence().  Signals are set with
+ * shmem_putmem_signal where available, or by an atomic set ordered after
+ * the data by shmem_fence. */
+template <>
+struct RemoteBlockTransfer<SHMEMSpaceSpecializeTag> {
+  template <class T>
+  static T* direct(const SHMEMDataHandle<T>& handle, const int pe) {
+    if (handle.peers && handle.peers[pe])
+      return static_cast<T*>(handle.peers[pe]) + handle.peer_offset;
+    return NULL;
+  }
+
+  template <class T, class RemoteView>
+  static void get(T* dst, const RemoteView& src, const int pe,
+                  const size_t offset, const size_t count) {
+    const SHMEMDataHandle<T>& handle = src.impl_map().handle();
+    if (T* ptr = direct(handle, pe))
+      memcpy(dst, ptr + offset, count * sizeof(T));
+    else
+      shmem_getmem(dst, handle.ptr + offset, count * sizeof(T),
+                   handle.world_pe(pe));
+  }
+
+  template <class T, class RemoteView>
+  static void put(const T* src, const RemoteView& dst, const int pe,
+                  const size_t offset, const size_t count) {
+    const SHMEMDataHandle<T>& handle = dst.impl_map().handle();
+    if (T* ptr = direct(handle, pe))
+      memcpy(ptr + offset, src, count * sizeof(T));
+    else
+      shmem_putmem(handle.ptr + offset, src, count * sizeof(T),
+                   handle.world_pe(pe));
+  }
+
+  template <class T, class RemoteView>
+  static void get_async(T* dst, const RemoteView& src, const int pe,
+                        const size_t offset, const size_t count) {
+    const SHMEMDataHandle<T>& handle = src.impl_map().handle();
+    if (T* ptr = direct(handle, pe))
+      memcpy(dst, ptr + offset, count * sizeof(T));
+    else
+      shmem_getmem_nbi(dst, handle.ptr + offset, count * sizeof(T),
+                       handle.world_pe(pe));
+  }
+
+  template <class T, class RemoteView, class SignalView>
+  static void put_signal(const T* src, const RemoteView& dst, const int pe,
+                         const size_t offset, const size_t count,
+                         const SignalView& signal, const size_t idx,
+                         const uint64_t value) {
+    const SHMEMDataHandle<T>& handle = dst.impl_map().handle();
+    uint64_t* const sig = signal.impl_map().handle().ptr + idx;
+#ifdef KOKKOS_ENABLE_SHMEM_PUT_SIGNAL
+    if (!direct(handle, pe)) {
+      shmem_putmem_signal(handle.ptr + offset, src, count * sizeof(T), sig,
+                          value, SHMEM_SIGNAL_SET, handle.world_pe(pe));
+      return;
     }
 #endif
-
-    //  Only initialize if the allocation is non-zero.
-    //  May be zero if one of the dimensions is zero.
-    if (alloc_size && alloc_prop::initialize) {
-      // Assume destruction is only required when construction is requested.
-      // The ViewValueFunctor has both value construction and destruction
-      // operators.
-      /*record->m_destroy = functor_type( (
-         (Kokkos::Impl::ViewCtorProp<void,execution_space> const &)
-         arg_prop).value , (value_type *) m_handle , m_offset.span()
-                                      );*/
-
-      // Construct values
-      record->m_destroy.construct_shared_allocation();
+    put(src, dst, pe, offset, count);
+    // Deliver the data, stored directly or put, before the signal
+    static_assert(sizeof(unsigned long long) == sizeof(uint64_t),
+                  "SHMEM signals require 64 bit unsigned long long");
+    std::atomic_thread_fence(std::memory_order_release);
+    shmem_fence();
+    shmem_ulonglong_atomic_set(reinterpret_cast<unsigned long long*>(sig),
+                               value, handle.world_pe(pe));
+  }
+
+  static int cmp(const int remote_cmp) {
+    switch (remote_cmp) {
+      case Experimental::RemoteCmpEq: return SHMEM_CMP_EQ;
+      case Experimental::RemoteCmpNe: return SHMEM_CMP_NE;
+      case Experimental::RemoteCmpGt: return SHMEM_CMP_GT;
+      case Experimental::RemoteCmpGe: return SHMEM_CMP_GE;
+      case Experimental::RemoteCmpLt: return SHMEM_CMP_LT;
+      case Experimental::RemoteCmpLe: return SHMEM_CMP_LE;
     }
-
-    return record;
+    Kokkos::abort("Unknown remote_wait_until comparison.");
+    return SHMEM_CMP_EQ;
+  }
+
+  template <class SignalView>
+  static void wait_until(const SignalView& signal, const size_t idx,
+                         const int remote_cmp, const uint64_t value) {
+    shmem_uint64_wait_until(signal.data() + idx, cmp(remote_cmp), value);
+    std::atomic_thread_fence(std::memory_order_acquire);
+  }
+
+  // Strided runs use the 32 and 64 bit strided routines where they apply
+  template <class T>
+  static void strided(T* local, const SHMEMDataHandle<T>& handle,
+                      const int pe, const int rank, const size_t* extents,
+                      const size_t* strides, const bool put) {
+    if (T* ptr = direct(handle, pe)) {
+      remote_strided_runs(rank, extents, strides,
+                          [&](size_t l, size_t r, size_t n, size_t stride) {
+                            for (size_t j = 0; j < n; j++) {
+                              if (put)
+                                ptr[r + j * stride] = local[l + j];
+                              else
+                                local[l + j] = ptr[r + j * stride];
+                            }
+                          });
+      return;
+    }
+    T* const remote  = handle.ptr;
+    const int target = handle.world_pe(pe);
+    remote_strided_runs(
+        rank, extents, strides,
+        [&](size_t l, size_t r, size_t n, size_t stride) {
+          if (stride == 1) {
+            if (put)
+              shmem_putmem(remote + r, local + l, n * sizeof(T), target);
+            else
+              shmem_getmem(local + l, remote + r, n * sizeof(T), target);
+          } else if (sizeof(T) == 4 || sizeof(T) == 8) {
+            if (put && sizeof(T) == 4)
+              shmem_iput32(remote + r, local + l, stride, 1, n, target);
+            else if (put)
+              shmem_iput64(remote + r, local + l, stride, 1, n, target);
+            else if (sizeof(T) == 4)
+              shmem_iget32(local + l, remote + r, 1, stride, n, target);
+            else
+              shmem_iget64(local + l, remote + r, 1, stride, n, target);
+          } else {
+            for (size_t j = 0; j < n; j++) {
+              if (put)
+                shmem_putmem(remote + r + j * stride, local + l + j, sizeof(T),
+                             target);
+              else
+                shmem_getmem(local + l + j, remote + r + j * stride, sizeof(T),
+                             target);
+            }
+          }
+        });
+  }
+
+  template <class T, class RemoteView>
+  static void get_strided(T* dst, const RemoteView& src, const int pe,
+                          const int rank, const size_t* extents,
+                          const size_t* strides) {
+    strided(dst, src.impl_map().handle(), pe, rank, extents, strides, false);
+  }
+
+  template <class T, class RemoteView>
+  static void put_strided(const T* src, const RemoteView& dst, const int pe,
+                          const int rank, const size_t* extents,
+                          const size_t* strides) {
+    strided(const_cast<T*>(src), dst.impl_map().handle(), pe, rank, extents,
+            strides, true);
   }
 };
 
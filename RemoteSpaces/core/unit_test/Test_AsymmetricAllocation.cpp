@@ -0,0 +1,124 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  H. Carter Edwards (hcedwar@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef TEST_ASYMMETRIC_ALLOCATION_HPP_
+#define TEST_ASYMMETRIC_ALLOCATION_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+
+#ifdef KOKKOS_ENABLE_SHMEM_TEST
+#define KOKKOS_TEST_REMOTE_MEMORY_SPACE Kokkos::SHMEMSpace
+#endif
+#ifdef KOKKOS_ENABLE_MPI_TEST
+#define KOKKOS_TEST_REMOTE_MEMORY_SPACE Kokkos::MPISpace
+#endif
+
+template <class DataType, class RemoteSpace>
+void test_asymmetric_allocation(const int N, const int M) {
+  int myRank, numRanks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+  MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+  const int target = (myRank + 1) % numRanks;
+
+  // Rank r owns (r + 1) * N rows of M elements
+  typedef Kokkos::View<DataType***, RemoteSpace> remote_view_type;
+  remote_view_type v =
+      Kokkos::allocate_asymmetric_remote_view<remote_view_type>(
+          "MyView", numRanks, NULL, (myRank + 1) * N, M);
+  for (int pe = 0; pe < numRanks; pe++) {
+    ASSERT_EQ(Kokkos::Experimental::get_partition_extent(v, pe),
+              size_t((pe + 1) * N));
+    ASSERT_EQ(Kokkos::Experimental::get_partition_offset(v, pe),
+              size_t(pe * (pe + 1) / 2 * N));
+    ASSERT_EQ(Kokkos::Experimental::get_partition_owner(
+                  v, pe * (pe + 1) / 2 * N),
+              pe);
+    ASSERT_EQ(Kokkos::Experimental::get_partition_owner(
+                  v, (pe + 1) * (pe + 2) / 2 * N - 1),
+              pe);
+  }
+
+  // Dimension 1 spans the largest partition, the local view only its own
+  ASSERT_EQ(v.extent(1), size_t(numRanks * N));
+  ASSERT_EQ(Kokkos::Experimental::local_view(v).extent(0),
+            size_t((myRank + 1) * N));
+
+  const size_t offset = Kokkos::Experimental::get_partition_offset(v, myRank);
+  DataType* local     = v.data();
+  for (int i = 0; i < (myRank + 1) * N * M; i++)
+    local[i] = DataType(offset * M + i);
+  RemoteSpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  const int rows = Kokkos::Experimental::get_partition_extent(v, target);
+  const size_t target_offset =
+      Kokkos::Experimental::get_partition_offset(v, target);
+  for (int i = 0; i < rows; i++)
+    for (int j = 0; j < M; j++)
+      ASSERT_EQ(DataType(v(target, i, j)),
+                DataType((target_offset + i) * M + j));
+
+  auto sub = Kokkos::subview(v, target, Kokkos::ALL, Kokkos::ALL);
+  ASSERT_EQ(sub.extent(0), size_t(rows));
+  for (int i = 0; i < rows; i++)
+    ASSERT_EQ(DataType(sub(i, M - 1)),
+              DataType((target_offset + i + 1) * M - 1));
+
+  Kokkos::View<DataType*, Kokkos::HostSpace> all("All", rows * M);
+  Kokkos::Experimental::remote_get(all, v, target);
+  RemoteSpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+  for (int i = 0; i < rows * M; i++)
+    ASSERT_EQ(all(i), DataType(target_offset * M + i));
+  RemoteSpace().fence();
+}
+
+TEST(asymmetric_allocation, extents_and_access) {
+  test_asymmetric_allocation<int, KOKKOS_TEST_REMOTE_MEMORY_SPACE>(16, 4);
+  test_asymmetric_allocation<double, KOKKOS_TEST_REMOTE_MEMORY_SPACE>(128, 3);
+}
+
+#endif /* TEST_ASYMMETRIC_ALLOCATION_HPP_ */
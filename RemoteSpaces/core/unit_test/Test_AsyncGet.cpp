@@ -0,0 +1,100 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  H. Carter Edwards (hcedwar@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef TEST_ASYNC_GET_HPP_
+#define TEST_ASYNC_GET_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+#include <vector>
+
+#ifdef KOKKOS_ENABLE_SHMEM_TEST
+#define KOKKOS_TEST_REMOTE_MEMORY_SPACE Kokkos::SHMEMSpace
+#endif
+#ifdef KOKKOS_ENABLE_MPI_TEST
+#define KOKKOS_TEST_REMOTE_MEMORY_SPACE Kokkos::MPISpace
+#endif
+
+template <class DataType, class RemoteSpace>
+void test_async_get(const int N) {
+  int myRank, numRanks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+  MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+  const int target = (myRank + 1) % numRanks;
+
+  typedef Kokkos::View<DataType**, RemoteSpace> remote_view_type;
+  remote_view_type v =
+      Kokkos::allocate_symmetric_remote_view<remote_view_type>(
+          "MyView", numRanks, NULL, N);
+  DataType* local = v.data();
+  for (int i = 0; i < N; i++) local[i] = DataType(myRank * N + i);
+  RemoteSpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  // Keep every element read and one bulk read in flight at once
+  std::vector<Kokkos::Experimental::RemoteFuture<DataType> > values;
+  for (int i = 0; i < N; i++)
+    values.push_back(
+        Kokkos::Experimental::remote_get_async(v, i % numRanks, i));
+  Kokkos::View<DataType*, Kokkos::HostSpace> part("Part", N / 2);
+  Kokkos::Experimental::remote_get_async(
+      part, v, target, Kokkos::pair<size_t, size_t>(N / 4, N / 4 + N / 2));
+
+  RemoteSpace().wait_all();
+  RemoteSpace().fence();
+  for (int i = 0; i < N; i++)
+    ASSERT_EQ(values[i].get(), DataType((i % numRanks) * N + i));
+  for (int i = 0; i < N / 2; i++)
+    ASSERT_EQ(part(i), DataType(target * N + N / 4 + i));
+  MPI_Barrier(MPI_COMM_WORLD);
+  RemoteSpace().fence();
+}
+
+TEST(remote_get_async, element_and_range) {
+  test_async_get<int, KOKKOS_TEST_REMOTE_MEMORY_SPACE>(1024);
+  test_async_get<double, KOKKOS_TEST_REMOTE_MEMORY_SPACE>(4096);
+}
+
+#endif /* TEST_ASYNC_GET_HPP_ */
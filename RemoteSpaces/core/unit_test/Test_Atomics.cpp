@@ -0,0 +1,218 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  H. Carter Edwards (hcedwar@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef TEST_ATOMICS_HPP_
+#define TEST_ATOMICS_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#ifdef KOKKOS_ENABLE_SHMEM_TEST
+#define KOKKOS_TEST_REMOTE_MEMORY_SPACE Kokkos::SHMEMSpace
+#endif
+#ifdef KOKKOS_ENABLE_MPI_TEST
+#define KOKKOS_TEST_REMOTE_MEMORY_SPACE Kokkos::MPISpace
+#endif
+
+template <class DataType, class RemoteSpace>
+void test_atomic_histogram(const int N, const int updates) {
+  int myRank, numRanks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+  MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+
+  typedef Kokkos::View<DataType**, RemoteSpace> remote_view_type;
+  remote_view_type v =
+      Kokkos::allocate_symmetric_remote_view<remote_view_type>(
+          "MyView", numRanks, NULL, N);
+  DataType* local = v.data();
+  for (int i = 0; i < N; i++) local[i] = DataType(0);
+  RemoteSpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  // Every rank updates every bin of every rank
+  for (int u = 0; u < updates; u++)
+    for (int pe = 0; pe < numRanks; pe++)
+      for (int i = 0; i < N; i++) {
+        v(pe, i) += DataType(1);
+        v(pe, i)++;
+        v(pe, i) -= DataType(1);
+      }
+  RemoteSpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  for (int i = 0; i < N; i++)
+    ASSERT_EQ(local[i], DataType(updates * numRanks));
+}
+
+template <class DataType, class RemoteSpace>
+void test_atomic_bitwise() {
+  int myRank, numRanks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+  MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+
+  typedef Kokkos::View<DataType**, RemoteSpace> remote_view_type;
+  remote_view_type v =
+      Kokkos::allocate_symmetric_remote_view<remote_view_type>(
+          "MyView", numRanks, NULL, 3);
+  DataType* local = v.data();
+  local[0] = DataType(0);
+  local[1] = DataType(0);
+  local[2] = ~DataType(0);
+  RemoteSpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  // Every rank flips its bit in every rank's elements
+  const int bits = sizeof(DataType) * 8 - 1;
+  for (int pe = 0; pe < numRanks; pe++) {
+    v(pe, 0) |= DataType(1) << (myRank % bits);
+    v(pe, 1) ^= DataType(1) << (myRank % bits);
+    v(pe, 2) &= ~(DataType(1) << (myRank % bits));
+  }
+  RemoteSpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  DataType set = DataType(0), flipped = DataType(0);
+  for (int r = 0; r < numRanks; r++) {
+    set |= DataType(1) << (r % bits);
+    flipped ^= DataType(1) << (r % bits);
+  }
+  ASSERT_EQ(local[0], set);
+  ASSERT_EQ(local[1], flipped);
+  ASSERT_EQ(local[2], DataType(~set));
+  RemoteSpace().fence();
+}
+
+// The values returned by fetching operators must be valid on return, in
+// the default RMA mode as well
+template <class DataType, class RemoteSpace>
+void test_atomic_fetch(const int updates) {
+  int myRank, numRanks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+  MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+
+  typedef Kokkos::View<DataType**, RemoteSpace> remote_view_type;
+  remote_view_type v =
+      Kokkos::allocate_symmetric_remote_view<remote_view_type>(
+          "MyView", numRanks, NULL, 1);
+  v.data()[0] = DataType(0);
+  RemoteSpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  // Every rank takes tickets from the counter of rank 0
+  std::vector<long> tickets(updates), all(updates * numRanks);
+  for (int u = 0; u < updates; u++) {
+    if (u % 2)
+      tickets[u] = long(v(0, 0)++);
+    else
+      tickets[u] = long(v(0, 0) += DataType(1)) - 1;
+  }
+  RemoteSpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  MPI_Allgather(tickets.data(), updates, MPI_LONG, all.data(), updates,
+                MPI_LONG, MPI_COMM_WORLD);
+  std::sort(all.begin(), all.end());
+  for (int i = 0; i < updates * numRanks; i++) ASSERT_EQ(all[i], long(i));
+  if (myRank == 0) ASSERT_EQ(v.data()[0], DataType(updates * numRanks));
+}
+
+// Reads and updates right after a put to the same element must observe it,
+// including puts still buffered for aggregation
+template <class DataType, class RemoteSpace>
+void test_atomic_after_put(const int updates) {
+  int myRank, numRanks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+  MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+  const int target = (myRank + 1) % numRanks;
+
+  typedef Kokkos::View<DataType**, RemoteSpace> remote_view_type;
+  remote_view_type v =
+      Kokkos::allocate_symmetric_remote_view<remote_view_type>(
+          "MyView", numRanks, NULL, numRanks);
+  RemoteSpace().fence();
+
+  for (int u = 0; u < updates; u++) {
+    v(target, myRank) = DataType(u);
+    ASSERT_EQ(DataType(v(target, myRank)), DataType(u));
+    v(target, myRank) = DataType(2 * u);
+    ASSERT_EQ(DataType(v(target, myRank) += DataType(1)), DataType(2 * u + 1));
+  }
+  RemoteSpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  const int source = (myRank + numRanks - 1) % numRanks;
+  ASSERT_EQ(v.data()[source], DataType(2 * (updates - 1) + 1));
+}
+
+TEST(atomics, histogram) {
+  test_atomic_histogram<int, KOKKOS_TEST_REMOTE_MEMORY_SPACE>(16, 10);
+  test_atomic_histogram<double, KOKKOS_TEST_REMOTE_MEMORY_SPACE>(16, 10);
+}
+
+TEST(atomics, bitwise) {
+  test_atomic_bitwise<int, KOKKOS_TEST_REMOTE_MEMORY_SPACE>();
+  test_atomic_bitwise<unsigned long, KOKKOS_TEST_REMOTE_MEMORY_SPACE>();
+}
+
+TEST(atomics, fetch) {
+  test_atomic_fetch<int, KOKKOS_TEST_REMOTE_MEMORY_SPACE>(100);
+  test_atomic_fetch<long, KOKKOS_TEST_REMOTE_MEMORY_SPACE>(100);
+}
+
+#ifdef KOKKOS_ENABLE_MPI_TEST
+TEST(atomics, after_put) {
+  for (int aggregate = 0; aggregate < 2; aggregate++) {
+    Kokkos::MPISpace::set_put_aggregation(aggregate, 64);
+    test_atomic_after_put<int, Kokkos::MPISpace>(100);
+    test_atomic_after_put<double, Kokkos::MPISpace>(100);
+  }
+  Kokkos::MPISpace::set_put_aggregation(false);
+}
+#endif
+
+#endif /* TEST_ATOMICS_HPP_ */
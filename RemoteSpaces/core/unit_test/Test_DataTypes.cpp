@@ -0,0 +1,142 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  H. Carter Edwards (hcedwar@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef TEST_DATA_TYPES_HPP_
+#define TEST_DATA_TYPES_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+
+#include <cstdint>
+
+struct TestParticle {
+  double x, y, z;
+  int64_t id;
+};
+
+template <class T>
+struct TestValue {
+  static T make(const int rank, const int i) { return T(rank * 1000 + i); }
+  static bool equal(const T& a, const T& b) { return a == b; }
+};
+
+template <>
+struct TestValue<TestParticle> {
+  static TestParticle make(const int rank, const int i) {
+    TestParticle p = {double(rank), double(i), 0.5, int64_t(rank) << 40};
+    return p;
+  }
+  static bool equal(const TestParticle& a, const TestParticle& b) {
+    return a.x == b.x && a.y == b.y && a.z == b.z && a.id == b.id;
+  }
+};
+
+template <class DataType>
+void test_data_type(const int N) {
+  int myRank, numRanks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+  MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+  const int target = (myRank + 1) % numRanks;
+  const int source = (myRank + numRanks - 1) % numRanks;
+
+  typedef TestValue<DataType> value;
+  typedef Kokkos::View<DataType**, Kokkos::MPISpace> remote_view_type;
+  remote_view_type v =
+      Kokkos::allocate_symmetric_remote_view<remote_view_type>(
+          "MyView", numRanks, NULL, N);
+  Kokkos::MPISpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  for (int i = 0; i < N; i++) v(target, i) = value::make(myRank, i);
+  Kokkos::MPISpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  DataType* local = v.data();
+  for (int i = 0; i < N; i++)
+    ASSERT_TRUE(value::equal(local[i], value::make(source, i)));
+  for (int i = 0; i < N; i++) {
+    DataType remote = v(target, i);
+    ASSERT_TRUE(value::equal(remote, value::make(myRank, i)));
+  }
+  Kokkos::MPISpace().fence();
+}
+
+template <class DataType>
+void test_data_type_atomic(const int N) {
+  int myRank, numRanks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+  MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+
+  typedef Kokkos::View<DataType*, Kokkos::MPISpace> remote_view_type;
+  remote_view_type v =
+      Kokkos::allocate_symmetric_remote_view<remote_view_type>(
+          "MyView", numRanks, NULL);
+  v.data()[0] = DataType(0);
+  Kokkos::MPISpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  for (int i = 0; i < N; i++) v(0) += DataType(1);
+  Kokkos::MPISpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  if (myRank == 0) ASSERT_EQ(v.data()[0], DataType(N * numRanks));
+  Kokkos::MPISpace().fence();
+}
+
+TEST(data_types, put_get) {
+  test_data_type<float>(100);
+  test_data_type<int64_t>(100);
+  test_data_type<unsigned short>(100);
+  test_data_type<Kokkos::complex<double> >(100);
+  test_data_type<TestParticle>(100);
+}
+
+TEST(data_types, atomic) {
+  test_data_type_atomic<float>(100);
+  test_data_type_atomic<int64_t>(100);
+  test_data_type_atomic<Kokkos::complex<double> >(100);
+}
+
+#endif /* TEST_DATA_TYPES_HPP_ */
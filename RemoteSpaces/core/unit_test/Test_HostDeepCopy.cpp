@@ -0,0 +1,103 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  H. Carter Edwards (hcedwar@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef TEST_HOST_DEEP_COPY_HPP_
+#define TEST_HOST_DEEP_COPY_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+
+#ifdef KOKKOS_ENABLE_SHMEM_TEST
+#define KOKKOS_TEST_REMOTE_MEMORY_SPACE Kokkos::SHMEMSpace
+#endif
+#ifdef KOKKOS_ENABLE_MPI_TEST
+#define KOKKOS_TEST_REMOTE_MEMORY_SPACE Kokkos::MPISpace
+#endif
+
+template <class DataType, class RemoteSpace>
+void test_host_deep_copy(const int N) {
+  int myRank, numRanks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+  MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+  const int target = (myRank + 1) % numRanks;
+
+  typedef Kokkos::View<DataType**, RemoteSpace> remote_view_type;
+  typedef Kokkos::View<DataType*, Kokkos::HostSpace> host_view_type;
+  remote_view_type v("MyView", numRanks, N);
+  host_view_type h("HostView", N), h_back("HostViewBack", N);
+
+  for (int i = 0; i < N; i++) h(i) = DataType(myRank * N + i);
+
+  // Stage the local partition from and back into host memory
+  Kokkos::deep_copy(v, h);
+  RemoteSpace().fence();
+
+  for (int i = 0; i < N; i++)
+    ASSERT_EQ(DataType(v(target, i)), DataType(target * N + i));
+  RemoteSpace().fence();
+
+  Kokkos::deep_copy(h_back, v);
+  for (int i = 0; i < N; i++) ASSERT_EQ(h_back(i), h(i));
+
+  // A subview restricted to the calling rank addresses the same memory
+  Kokkos::deep_copy(h_back, DataType(0));
+  Kokkos::deep_copy(h_back, Kokkos::subview(v, myRank, Kokkos::ALL));
+  for (int i = 0; i < N; i++) ASSERT_EQ(h_back(i), h(i));
+
+  // The mirror of the local partition aliases host accessible memory
+  auto mirror = Kokkos::Experimental::create_local_mirror_view(v);
+  ASSERT_EQ(mirror.extent(0), size_t(N));
+  Kokkos::deep_copy(mirror, h_back);
+  for (int i = 0; i < N; i++) ASSERT_EQ(mirror(i), h(i));
+  RemoteSpace().fence();
+}
+
+TEST(host_deep_copy, local_partition) {
+  test_host_deep_copy<int, KOKKOS_TEST_REMOTE_MEMORY_SPACE>(1);
+  test_host_deep_copy<int, KOKKOS_TEST_REMOTE_MEMORY_SPACE>(4096);
+  test_host_deep_copy<double, KOKKOS_TEST_REMOTE_MEMORY_SPACE>(1 << 20);
+}
+
+#endif /* TEST_HOST_DEEP_COPY_HPP_ */
@@ -0,0 +1,95 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  H. Carter Edwards (hcedwar@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef TEST_HUGE_PAGES_HPP_
+#define TEST_HUGE_PAGES_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <unistd.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+
+template <class DataType>
+void test_huge_pages(const int N) {
+  int myRank, numRanks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+  MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+  const int target = (myRank + 1) % numRanks;
+  const int source = (myRank + numRanks - 1) % numRanks;
+
+  typedef Kokkos::View<DataType**, Kokkos::MPISpace> remote_view_type;
+  remote_view_type v =
+      Kokkos::allocate_symmetric_remote_view<remote_view_type>(
+          "MyView", numRanks, NULL, N);
+  DataType* local = v.data();
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(local) % sysconf(_SC_PAGESIZE), 0u);
+  for (int i = 0; i < N; i++) local[i] = DataType(0);
+  Kokkos::MPISpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  for (int i = 0; i < N; i++) v(target, i) = DataType(myRank * N + i);
+  v(target, 0) += DataType(1);
+  Kokkos::MPISpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  for (int i = 0; i < N; i++)
+    ASSERT_EQ(local[i], DataType(source * N + i + (i == 0 ? 1 : 0)));
+  ASSERT_EQ(DataType(v(target, N - 1)), DataType(myRank * N + N - 1));
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(huge_pages, put_get) {
+  Kokkos::MPISpace::set_huge_pages(true);
+  test_huge_pages<int>(100);
+  test_huge_pages<double>(1 << 20);
+  Kokkos::MPISpace::set_huge_pages(false);
+}
+
+TEST(huge_pages, relaxed_accumulate_ordering) {
+  Kokkos::MPISpace::set_relaxed_accumulate_ordering(true);
+  test_huge_pages<int>(100);
+  Kokkos::MPISpace::set_relaxed_accumulate_ordering(false);
+}
+
+#endif /* TEST_HUGE_PAGES_HPP_ */
@@ -0,0 +1,122 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  H. Carter Edwards (hcedwar@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef TEST_LARGE_OFFSETS_HPP_
+#define TEST_LARGE_OFFSETS_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef KOKKOS_ENABLE_SHMEM_TEST
+#define KOKKOS_TEST_REMOTE_MEMORY_SPACE Kokkos::SHMEMSpace
+#endif
+#ifdef KOKKOS_ENABLE_MPI_TEST
+#define KOKKOS_TEST_REMOTE_MEMORY_SPACE Kokkos::MPISpace
+#endif
+
+template <class RemoteSpace>
+void test_large_offsets() {
+  int myRank, numRanks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+  MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+  const int target = (myRank + 1) % numRanks;
+  const int source = (myRank + numRanks - 1) % numRanks;
+
+  // Partitions of more than 2^31 elements
+  const size_t N     = (size_t(1) << 31) + 256;
+  const size_t first = N - 512;
+
+  // Every rank needs more than 2 GiB.  Only run when asked for, and skip
+  // on all ranks if one of them cannot get the memory.
+  const bool requested = std::getenv("KOKKOS_REMOTE_SPACES_LARGE_TESTS");
+  void* probe          = requested ? std::malloc(N) : NULL;
+  int available        = probe != NULL;
+  std::free(probe);
+  MPI_Allreduce(MPI_IN_PLACE, &available, 1, MPI_INT, MPI_LAND,
+                MPI_COMM_WORLD);
+  if (!available) {
+    if (myRank == 0)
+      printf("Skipping large_offsets: %s\n",
+             requested ? "out of memory"
+                       : "set KOKKOS_REMOTE_SPACES_LARGE_TESTS to run it");
+    return;
+  }
+
+  typedef Kokkos::View<char**, RemoteSpace> remote_view_type;
+  remote_view_type v =
+      Kokkos::allocate_symmetric_remote_view<remote_view_type>(
+          "MyView", numRanks, NULL, N);
+  char* local = v.data();
+  for (size_t i = first; i < N; i++) local[i] = char(myRank + i);
+  RemoteSpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  for (size_t i = first; i < N; i++)
+    ASSERT_EQ(char(v(target, i)), char(target + i));
+
+  // A range crossing the 2^31 boundary
+  Kokkos::View<char*, Kokkos::HostSpace> range("Range", 512);
+  Kokkos::Experimental::remote_get(range, v, target,
+                                   Kokkos::pair<size_t, size_t>(first, N));
+  RemoteSpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+  for (size_t i = 0; i < 512; i++)
+    ASSERT_EQ(range(i), char(target + first + i));
+
+  v(target, N - 1) = char(myRank + 7);
+  RemoteSpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+  ASSERT_EQ(local[N - 1], char(source + 7));
+  RemoteSpace().fence();
+}
+
+TEST(large_offsets, access_past_2_31) {
+  test_large_offsets<KOKKOS_TEST_REMOTE_MEMORY_SPACE>();
+}
+
+#endif /* TEST_LARGE_OFFSETS_HPP_ */
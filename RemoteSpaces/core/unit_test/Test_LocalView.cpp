@@ -0,0 +1,102 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  H. Carter Edwards (hcedwar@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef TEST_LOCAL_VIEW_HPP_
+#define TEST_LOCAL_VIEW_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+
+#ifdef KOKKOS_ENABLE_SHMEM_TEST
+#define KOKKOS_TEST_REMOTE_MEMORY_SPACE Kokkos::SHMEMSpace
+#endif
+#ifdef KOKKOS_ENABLE_MPI_TEST
+#define KOKKOS_TEST_REMOTE_MEMORY_SPACE Kokkos::MPISpace
+#endif
+
+template <class DataType, class RemoteSpace>
+void test_local_view(const int N, const int M) {
+  int myRank, numRanks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+  MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+  const int target = (myRank + 1) % numRanks;
+
+  // Rank r owns (r + 1) * N rows of M elements
+  typedef Kokkos::View<DataType***, RemoteSpace> remote_view_type;
+  remote_view_type v =
+      Kokkos::allocate_asymmetric_remote_view<remote_view_type>(
+          "MyView", numRanks, NULL, (myRank + 1) * N, M);
+
+  auto local = Kokkos::Experimental::local_view(v);
+  static_assert(decltype(local)::rank == 2, "local_view drops the rank index");
+  ASSERT_EQ(local.data(), v.data());
+  ASSERT_EQ(local.extent(0), size_t((myRank + 1) * N));
+  ASSERT_EQ(local.extent(1), size_t(M));
+  ASSERT_EQ(local.stride(0), v.stride(1));
+  ASSERT_EQ(local.stride(1), v.stride(2));
+
+  Kokkos::parallel_for(
+      "LocalView",
+      Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(
+          0, local.extent(0)),
+      [=](const size_t i) {
+        for (int j = 0; j < M; j++) local(i, j) = DataType(myRank * i + j);
+      });
+  Kokkos::fence();
+  RemoteSpace().fence();
+
+  const int rows = (target + 1) * N;
+  for (int i = 0; i < rows; i++)
+    for (int j = 0; j < M; j++)
+      ASSERT_EQ(DataType(v(target, i, j)), DataType(target * i + j));
+  RemoteSpace().fence();
+}
+
+TEST(local_view, owned_partition) {
+  test_local_view<int, KOKKOS_TEST_REMOTE_MEMORY_SPACE>(16, 4);
+  test_local_view<double, KOKKOS_TEST_REMOTE_MEMORY_SPACE>(64, 3);
+}
+
+#endif /* TEST_LOCAL_VIEW_HPP_ */
@@ -60,9 +60,12 @@ using shmem_init_attr_t = nvshmemx_init_attr_t;
 //   #define SHMEM_INIT_WITH_MPI_COMM SHMEMX_INIT_WITH_MPI_COMM
 
 int main(int argc, char *argv[]) {
-  MPI_Init(&argc, &argv);
+  // Tests issuing remote accesses from the threads of host execution spaces
+  // query the provided level and skip without thread-multiple support
+  int provided;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
 #if defined(KOKKOS_ENABLE_SHMEM_TEST)
-  shmem_init();
+  shmem_init_thread(SHMEM_THREAD_MULTIPLE, &provided);
 #endif
 #if defined(KOKKOS_ENABLE_NVSHMEM_TEST)
   MPI_Comm mpi_comm;
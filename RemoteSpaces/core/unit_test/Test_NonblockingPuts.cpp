@@ -0,0 +1,97 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  H. Carter Edwards (hcedwar@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef TEST_NONBLOCKING_PUTS_HPP_
+#define TEST_NONBLOCKING_PUTS_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+
+template <class DataType>
+void test_nonblocking_puts(const int N, const size_t chunk_size) {
+  int myRank, numRanks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+  MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+  const int target = (myRank + 1) % numRanks;
+  const int source = (myRank + numRanks - 1) % numRanks;
+
+  typedef Kokkos::View<DataType**, Kokkos::SHMEMSpace> remote_view_type;
+  remote_view_type v("MyView", numRanks, N);
+  Kokkos::SHMEMSpace().fence();
+
+  Kokkos::SHMEMSpace::set_nonblocking_puts(true, chunk_size);
+
+  // Local completion followed by a barrier of our choosing
+  Kokkos::parallel_for(
+      "Nonblocking puts", N,
+      KOKKOS_LAMBDA(const int i) { v(target, i) = DataType(myRank + i); });
+  Kokkos::SHMEMSpace().wait_all();
+  MPI_Barrier(MPI_COMM_WORLD);
+  for (int i = 0; i < N; i++) ASSERT_EQ(v.data()[i], DataType(source + i));
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  // Later writes to an element win
+  for (int i = 0; i < N; i++) v(target, i) = DataType(-1);
+  for (int i = 0; i < N; i++) v(target, i) = DataType(myRank * i);
+  Kokkos::SHMEMSpace().fence();
+  for (int i = 0; i < N; i++) ASSERT_EQ(v.data()[i], DataType(source * i));
+
+  Kokkos::SHMEMSpace::set_nonblocking_puts(false);
+  Kokkos::SHMEMSpace().fence();
+}
+
+TEST(nonblocking_puts, shmem) {
+  // Puts are staged from the threads of the host execution space
+  int provided;
+  shmem_query_thread(&provided);
+  if (provided < SHMEM_THREAD_MULTIPLE)
+    GTEST_SKIP() << "SHMEM_THREAD_MULTIPLE is not supported";
+  test_nonblocking_puts<int>(1, 65536);
+  test_nonblocking_puts<int>(4096, 256);
+  test_nonblocking_puts<double>(1024, 65536);
+  test_nonblocking_puts<double>(1024, sizeof(double));
+}
+
+#endif /* TEST_NONBLOCKING_PUTS_HPP_ */
@@ -0,0 +1,122 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  H. Carter Edwards (hcedwar@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef TEST_PARTITION_POLICY_HPP_
+#define TEST_PARTITION_POLICY_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+
+#ifdef KOKKOS_ENABLE_SHMEM_TEST
+#define KOKKOS_TEST_REMOTE_MEMORY_SPACE Kokkos::SHMEMSpace
+#endif
+#ifdef KOKKOS_ENABLE_MPI_TEST
+#define KOKKOS_TEST_REMOTE_MEMORY_SPACE Kokkos::MPISpace
+#endif
+
+template <class DataType, class RemoteSpace>
+void test_partition_policy(const int N, const int M) {
+  int myRank, numRanks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+  MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+  const int target = (myRank + 1) % numRanks;
+
+  // Rank r owns (r + 1) * N rows of M elements
+  typedef Kokkos::View<DataType***, RemoteSpace> remote_view_type;
+  remote_view_type v =
+      Kokkos::allocate_asymmetric_remote_view<remote_view_type>(
+          "MyView", numRanks, NULL, (myRank + 1) * N, M);
+  const size_t offset = Kokkos::Experimental::get_partition_offset(v, myRank);
+  const size_t extent = Kokkos::Experimental::get_partition_extent(v, myRank);
+
+  // Owner-computes loop over the local partition
+  DataType* local = v.data();
+  Kokkos::parallel_for(
+      "PartitionPolicy",
+      Kokkos::Experimental::LocalPartitionPolicy<
+          Kokkos::DefaultHostExecutionSpace>(v),
+      [=](const size_t i) {
+        for (int j = 0; j < M; j++)
+          local[i * M + j] = DataType((offset + i) * M + j);
+      });
+  Kokkos::fence();
+  RemoteSpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  const size_t target_offset =
+      Kokkos::Experimental::get_partition_offset(v, target);
+  const int rows = Kokkos::Experimental::get_partition_extent(v, target);
+  for (int i = 0; i < rows; i++)
+    for (int j = 0; j < M; j++)
+      ASSERT_EQ(DataType(v(target, i, j)),
+                DataType((target_offset + i) * M + j));
+
+  // A global range only visits the indices owned by this rank
+  const size_t begin = N / 2, end = N * numRanks;
+  size_t count = 0, first = extent;
+  Kokkos::parallel_reduce(
+      "RemoteRangePolicy",
+      Kokkos::Experimental::RemoteRangePolicy<
+          Kokkos::DefaultHostExecutionSpace>(v, begin, end),
+      [=](const size_t i, size_t& c) { c += (i < extent); }, count);
+  const size_t lo = std::min(std::max(begin, offset), offset + extent);
+  const size_t hi = std::max(std::min(end, offset + extent), lo);
+  ASSERT_EQ(count, hi - lo);
+  Kokkos::parallel_reduce(
+      "RemoteRangePolicyFirst",
+      Kokkos::Experimental::RemoteRangePolicy<
+          Kokkos::DefaultHostExecutionSpace>(v, begin, end),
+      [=](const size_t i, size_t& f) { f = i < f ? i : f; },
+      Kokkos::Min<size_t>(first));
+  if (hi > lo) ASSERT_EQ(first, lo - offset);
+  RemoteSpace().fence();
+}
+
+TEST(partition_policy, owner_computes) {
+  test_partition_policy<int, KOKKOS_TEST_REMOTE_MEMORY_SPACE>(16, 4);
+  test_partition_policy<double, KOKKOS_TEST_REMOTE_MEMORY_SPACE>(64, 3);
+}
+
+#endif /* TEST_PARTITION_POLICY_HPP_ */
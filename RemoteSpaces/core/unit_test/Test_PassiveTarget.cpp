@@ -0,0 +1,91 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  H. Carter Edwards (hcedwar@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef TEST_PASSIVE_TARGET_HPP_
+#define TEST_PASSIVE_TARGET_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+
+template <class DataType>
+void test_passive_target(const int N) {
+  int myRank, numRanks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+  MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+  const int target = (myRank + 1) % numRanks;
+
+  typedef Kokkos::View<DataType**, Kokkos::MPISpace> remote_view_type;
+  remote_view_type v =
+      Kokkos::allocate_symmetric_remote_view<remote_view_type>(
+          "MyView", numRanks, NULL, N);
+  DataType* local = v.data();
+  for (int i = 0; i < N; i++) local[i] = DataType(0);
+  Kokkos::MPISpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  for (int i = 0; i < N; i++) v(target, i) = DataType(myRank * N + i);
+  // The put to element 0 must complete at the target before it is updated,
+  // MPI does not order a put and an accumulate to the same location
+  Kokkos::Experimental::fence(v);
+  v(target, 0) += DataType(1);
+  Kokkos::MPISpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  // Remote reads complete locally without an epoch-closing fence
+  for (int i = 0; i < N; i++) {
+    DataType expected = DataType(myRank * N + i + (i == 0 ? 1 : 0));
+    ASSERT_EQ(DataType(v(target, i)), expected);
+  }
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(passive_target, put_get) {
+  Kokkos::MPISpace::set_rma_mode(Kokkos::MPISpace::PassiveTarget);
+  test_passive_target<int>(100);
+  test_passive_target<double>(100);
+  Kokkos::MPISpace::set_rma_mode(Kokkos::MPISpace::ActiveTarget);
+}
+
+#endif /* TEST_PASSIVE_TARGET_HPP_ */
@@ -0,0 +1,95 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  H. Carter Edwards (hcedwar@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef TEST_PUT_AGGREGATION_HPP_
+#define TEST_PUT_AGGREGATION_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+
+template <class DataType>
+void test_put_aggregation(const int N, const size_t threshold) {
+  int myRank, numRanks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+  MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+
+  typedef Kokkos::View<DataType**, Kokkos::MPISpace> remote_view_type;
+  remote_view_type v =
+      Kokkos::allocate_symmetric_remote_view<remote_view_type>(
+          "MyView", numRanks, NULL, N);
+  DataType* local = v.data();
+  for (int i = 0; i < N; i++) local[i] = DataType(-1);
+  Kokkos::MPISpace().fence();
+
+  Kokkos::MPISpace::set_put_aggregation(true, threshold);
+  const int target = (myRank + 1) % numRanks;
+  const int source = (myRank + numRanks - 1) % numRanks;
+  // Contiguous, strided and repeated writes.  Small thresholds issue the
+  // first pass before the second one rewrites the same elements.
+  for (int i = 0; i < N / 2; i++) v(target, i) = DataType(-4);
+  for (int i = 0; i < N / 2; i++) v(target, i) = DataType(myRank * N + i);
+  for (int i = N / 2; i < N; i += 3) v(target, i) = DataType(myRank * N + i);
+  // Backward writes, both over earlier runs and into the gaps between them
+  for (int i = N - 1; i >= N / 4; i -= 2) v(target, i) = DataType(-2);
+  v(target, 0) = DataType(-3);
+  Kokkos::MPISpace().fence();
+  Kokkos::MPISpace::set_put_aggregation(false);
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  for (int i = 0; i < N; i++) {
+    DataType expected = DataType(-1);
+    if (i < N / 2 || (i - N / 2) % 3 == 0) expected = DataType(source * N + i);
+    if (i >= N / 4 && (N - 1 - i) % 2 == 0) expected = DataType(-2);
+    if (i == 0) expected = DataType(-3);
+    ASSERT_EQ(local[i], expected);
+  }
+}
+
+TEST(put_aggregation, scatter) {
+  test_put_aggregation<int>(1000, 65536);
+  test_put_aggregation<double>(1000, 64);
+}
+
+#endif /* TEST_PUT_AGGREGATION_HPP_ */
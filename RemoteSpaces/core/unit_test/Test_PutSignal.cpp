@@ -0,0 +1,116 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  H. Carter Edwards (hcedwar@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef TEST_PUT_SIGNAL_HPP_
+#define TEST_PUT_SIGNAL_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+
+#ifdef KOKKOS_ENABLE_SHMEM_TEST
+#define KOKKOS_TEST_REMOTE_MEMORY_SPACE Kokkos::SHMEMSpace
+#endif
+#ifdef KOKKOS_ENABLE_MPI_TEST
+#define KOKKOS_TEST_REMOTE_MEMORY_SPACE Kokkos::MPISpace
+#endif
+
+// Each rank streams steps to its neighbour, which waits for every step on
+// its signal instead of a fence
+template <class DataType, class RemoteSpace>
+void test_put_signal(const int N, const int steps) {
+  int myRank, numRanks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+  MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+  const int target = (myRank + 1) % numRanks;
+  const int source = (myRank + numRanks - 1) % numRanks;
+
+  typedef Kokkos::View<DataType**, RemoteSpace> remote_view_type;
+  typedef Kokkos::View<uint64_t**, RemoteSpace> signal_view_type;
+  typedef Kokkos::View<DataType*, Kokkos::HostSpace> local_view_type;
+  remote_view_type v =
+      Kokkos::allocate_symmetric_remote_view<remote_view_type>(
+          "MyView", numRanks, NULL, N * steps);
+  signal_view_type signal =
+      Kokkos::allocate_symmetric_remote_view<signal_view_type>(
+          "Signal", numRanks, NULL, 2);
+  signal.data()[0] = 0;
+  signal.data()[1] = 0;
+  RemoteSpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  local_view_type step("Step", N);
+  for (int s = 0; s < steps; s++) {
+    for (int i = 0; i < N; i++)
+      step(i) = DataType(myRank * steps * N + s * N + i);
+    Kokkos::Experimental::remote_put_signal(
+        v, step, target, Kokkos::pair<size_t, size_t>(s * N, (s + 1) * N),
+        signal, 1, s + 1);
+    Kokkos::Experimental::remote_wait_until(
+        signal, 1, Kokkos::Experimental::RemoteCmpGe, s + 1);
+    for (int i = 0; i < N; i++)
+      ASSERT_EQ(v.data()[s * N + i],
+                DataType(source * steps * N + s * N + i));
+  }
+  Kokkos::Experimental::remote_wait_until(
+      signal, 1, Kokkos::Experimental::RemoteCmpEq, steps);
+  ASSERT_EQ(signal.data()[0], uint64_t(0));
+  RemoteSpace().fence();
+}
+
+TEST(put_signal, pipeline) {
+#ifdef KOKKOS_ENABLE_MPI_TEST
+  // Signals are polled in passive-target epochs
+  const int rma_mode = Kokkos::MPISpace::rma_mode;
+  Kokkos::MPISpace::set_rma_mode(Kokkos::MPISpace::PassiveTarget);
+#endif
+  test_put_signal<int, KOKKOS_TEST_REMOTE_MEMORY_SPACE>(1, 8);
+  test_put_signal<int, KOKKOS_TEST_REMOTE_MEMORY_SPACE>(256, 4);
+  test_put_signal<double, KOKKOS_TEST_REMOTE_MEMORY_SPACE>(100, 16);
+#ifdef KOKKOS_ENABLE_MPI_TEST
+  Kokkos::MPISpace::set_rma_mode(rma_mode);
+#endif
+}
+
+#endif /* TEST_PUT_SIGNAL_HPP_ */
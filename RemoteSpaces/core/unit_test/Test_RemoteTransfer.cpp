@@ -0,0 +1,105 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  H. Carter Edwards (hcedwar@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef TEST_REMOTE_TRANSFER_HPP_
+#define TEST_REMOTE_TRANSFER_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+
+#ifdef KOKKOS_ENABLE_SHMEM_TEST
+#define KOKKOS_TEST_REMOTE_MEMORY_SPACE Kokkos::SHMEMSpace
+#endif
+#ifdef KOKKOS_ENABLE_MPI_TEST
+#define KOKKOS_TEST_REMOTE_MEMORY_SPACE Kokkos::MPISpace
+#endif
+
+template <class DataType, class RemoteSpace>
+void test_remote_get_put(const int N) {
+  int myRank, numRanks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+  MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+  const int target = (myRank + 1) % numRanks;
+  const int source = (myRank + numRanks - 1) % numRanks;
+
+  typedef Kokkos::View<DataType**, RemoteSpace> remote_view_type;
+  typedef Kokkos::View<DataType*, Kokkos::HostSpace> local_view_type;
+  remote_view_type v =
+      Kokkos::allocate_symmetric_remote_view<remote_view_type>(
+          "MyView", numRanks, NULL, N);
+  DataType* local = v.data();
+  for (int i = 0; i < N; i++) local[i] = DataType(myRank * N + i);
+  RemoteSpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  // Whole partition and a sub-range of the neighbour
+  local_view_type all("All", N);
+  local_view_type part("Part", N / 2);
+  Kokkos::Experimental::remote_get(all, v, target);
+  Kokkos::Experimental::remote_get(
+      part, v, target, Kokkos::pair<size_t, size_t>(N / 4, N / 4 + N / 2));
+  RemoteSpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+  for (int i = 0; i < N; i++) ASSERT_EQ(all(i), DataType(target * N + i));
+  for (int i = 0; i < N / 2; i++)
+    ASSERT_EQ(part(i), DataType(target * N + N / 4 + i));
+
+  for (int i = 0; i < N / 2; i++) part(i) = DataType(-myRank - 1);
+  Kokkos::Experimental::remote_put(
+      v, part, target, Kokkos::pair<size_t, size_t>(N / 2, N));
+  RemoteSpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+  for (int i = 0; i < N; i++)
+    ASSERT_EQ(local[i], i < N / 2 ? DataType(myRank * N + i)
+                                  : DataType(-source - 1));
+  RemoteSpace().fence();
+}
+
+TEST(remote_transfer, get_put) {
+  test_remote_get_put<int, KOKKOS_TEST_REMOTE_MEMORY_SPACE>(1024);
+  test_remote_get_put<double, KOKKOS_TEST_REMOTE_MEMORY_SPACE>(131072);
+}
+
+#endif /* TEST_REMOTE_TRANSFER_HPP_ */
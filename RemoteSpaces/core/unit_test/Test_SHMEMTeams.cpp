@@ -0,0 +1,101 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  H. Carter Edwards (hcedwar@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef TEST_SHMEM_TEAMS_HPP_
+#define TEST_SHMEM_TEAMS_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+
+#ifdef KOKKOS_ENABLE_SHMEM_TEAMS
+
+// Views spanning only the even PEs
+template <class DataType>
+void test_shmem_team(const int N) {
+  const int numWorldPEs = shmem_n_pes();
+  shmem_team_t team;
+  shmem_team_split_strided(SHMEM_TEAM_WORLD, 0, 2, (numWorldPEs + 1) / 2,
+                           NULL, 0, &team);
+
+  typedef Kokkos::View<DataType**, Kokkos::SHMEMSpace> remote_view_type;
+  {
+    // All PEs allocate, only the team gets partitions
+    Kokkos::SHMEMSpace space(team);
+    const int numRanks = space.num_pes();
+    remote_view_type v =
+        Kokkos::allocate_symmetric_remote_view<remote_view_type>(
+            "MyView", space, numRanks, NULL, N);
+    ASSERT_EQ(v.extent(0), size_t(numRanks));
+
+    if (team != SHMEM_TEAM_INVALID) {
+      const int myRank = space.my_pe();
+      const int target = (myRank + 1) % numRanks;
+      const int source = (myRank + numRanks - 1) % numRanks;
+
+      DataType* local = v.data();
+      for (int i = 0; i < N; i++) local[i] = DataType(0);
+      space.fence();
+
+      for (int i = 0; i < N; i++) v(target, i) = DataType(myRank * N + i);
+      space.fence();
+
+      for (int i = 0; i < N; i++)
+        ASSERT_EQ(local[i], DataType(source * N + i));
+      ASSERT_EQ(DataType(v(source, 1)), DataType(((source + numRanks - 1) %
+                                                  numRanks) * N + 1));
+      space.fence();
+    }
+  }
+  if (team != SHMEM_TEAM_INVALID) shmem_team_destroy(team);
+}
+
+TEST(shmem_team, put_get) {
+  test_shmem_team<int>(100);
+  test_shmem_team<double>(100);
+}
+
+#endif
+
+#endif /* TEST_SHMEM_TEAMS_HPP_ */
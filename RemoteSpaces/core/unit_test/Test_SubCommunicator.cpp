@@ -0,0 +1,95 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  H. Carter Edwards (hcedwar@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef TEST_SUB_COMMUNICATOR_HPP_
+#define TEST_SUB_COMMUNICATOR_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+
+// Views spanning only the even or the odd ranks of MPI_COMM_WORLD
+template <class DataType>
+void test_sub_communicator(const int N) {
+  int worldRank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &worldRank);
+  MPI_Comm comm;
+  MPI_Comm_split(MPI_COMM_WORLD, worldRank % 2, worldRank, &comm);
+
+  int myRank, numRanks;
+  MPI_Comm_rank(comm, &myRank);
+  MPI_Comm_size(comm, &numRanks);
+  const int target = (myRank + 1) % numRanks;
+  const int source = (myRank + numRanks - 1) % numRanks;
+
+  typedef Kokkos::View<DataType**, Kokkos::MPISpace> remote_view_type;
+  {
+    Kokkos::MPISpace space(comm);
+    remote_view_type v =
+        Kokkos::allocate_symmetric_remote_view<remote_view_type>(
+            "MyView", space, numRanks, NULL, N);
+    ASSERT_EQ(v.extent(0), size_t(numRanks));
+    DataType* local = v.data();
+    for (int i = 0; i < N; i++) local[i] = DataType(0);
+    space.fence();
+    MPI_Barrier(comm);
+
+    for (int i = 0; i < N; i++) v(target, i) = DataType(myRank * N + i);
+    space.fence();
+    MPI_Barrier(comm);
+
+    for (int i = 0; i < N; i++) ASSERT_EQ(local[i], DataType(source * N + i));
+    ASSERT_EQ(DataType(v(source, 1)), DataType(((source + numRanks - 1) %
+                                                numRanks) * N + 1));
+    space.fence();
+  }
+  MPI_Comm_free(&comm);
+}
+
+TEST(sub_communicator, put_get) {
+  test_sub_communicator<int>(100);
+  test_sub_communicator<double>(100);
+}
+
+#endif /* TEST_SUB_COMMUNICATOR_HPP_ */
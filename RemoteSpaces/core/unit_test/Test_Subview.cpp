@@ -0,0 +1,146 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  H. Carter Edwards (hcedwar@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef TEST_SUBVIEW_HPP_
+#define TEST_SUBVIEW_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+
+#ifdef KOKKOS_ENABLE_SHMEM_TEST
+#define KOKKOS_TEST_REMOTE_MEMORY_SPACE Kokkos::SHMEMSpace
+#endif
+#ifdef KOKKOS_ENABLE_MPI_TEST
+#define KOKKOS_TEST_REMOTE_MEMORY_SPACE Kokkos::MPISpace
+#endif
+
+template <class DataType, class RemoteSpace>
+void test_subview_deep_copy(const int N, const int M) {
+  int myRank, numRanks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+  MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+  const int target = (myRank + 1) % numRanks;
+  const int source = (myRank + numRanks - 1) % numRanks;
+  const int k      = M / 2;
+
+  typedef Kokkos::View<DataType***, RemoteSpace> remote_view_type;
+  remote_view_type v =
+      Kokkos::allocate_symmetric_remote_view<remote_view_type>(
+          "MyView", numRanks, NULL, N, M);
+  DataType* local = v.data();
+  for (int i = 0; i < N * M; i++) local[i] = DataType(myRank * N * M + i);
+  RemoteSpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  // A partition restricted to one rank is contiguous
+  auto partition = Kokkos::subview(v, target, Kokkos::ALL, Kokkos::ALL);
+  ASSERT_EQ(partition.extent(0), size_t(N));
+  ASSERT_EQ(partition.extent(1), size_t(M));
+  ASSERT_EQ(DataType(partition(1, 2)), DataType(target * N * M + M + 2));
+
+  Kokkos::View<DataType**, Kokkos::HostSpace> block("Block", N, M);
+  Kokkos::deep_copy(block, partition);
+  RemoteSpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+  for (int i = 0; i < N; i++)
+    for (int j = 0; j < M; j++)
+      ASSERT_EQ(block(i, j), DataType(target * N * M + i * M + j));
+
+  // A column of the partition is strided
+  auto column = Kokkos::subview(v, target, Kokkos::ALL, k);
+  Kokkos::View<DataType*, Kokkos::HostSpace> col("Column", N);
+  Kokkos::deep_copy(col, column);
+  RemoteSpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+  for (int i = 0; i < N; i++)
+    ASSERT_EQ(col(i), DataType(target * N * M + i * M + k));
+
+  for (int i = 0; i < N; i++) col(i) = DataType(-myRank - 1);
+  Kokkos::deep_copy(column, col);
+  RemoteSpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+  for (int i = 0; i < N; i++)
+    for (int j = 0; j < M; j++)
+      ASSERT_EQ(local[i * M + j],
+                j == k ? DataType(-source - 1)
+                       : DataType(myRank * N * M + i * M + j));
+  RemoteSpace().fence();
+}
+
+template <class DataType, class RemoteSpace>
+void test_subview_ranks(const int N) {
+  int myRank, numRanks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+  MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+
+  typedef Kokkos::View<DataType**, RemoteSpace> remote_view_type;
+  remote_view_type v =
+      Kokkos::allocate_symmetric_remote_view<remote_view_type>(
+          "MyView", numRanks, NULL, N);
+  DataType* local = v.data();
+  for (int i = 0; i < N; i++) local[i] = DataType(myRank * N + i);
+  RemoteSpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  // Keeping the rank index addresses every partition
+  auto range = Kokkos::subview(v, Kokkos::ALL,
+                               Kokkos::pair<int, int>(N / 4, N / 2));
+  ASSERT_EQ(range.extent(1), size_t(N / 2 - N / 4));
+  for (int pe = 0; pe < numRanks; pe++)
+    for (int i = 0; i < N / 2 - N / 4; i++)
+      ASSERT_EQ(DataType(range(pe, i)), DataType(pe * N + N / 4 + i));
+  RemoteSpace().fence();
+}
+
+TEST(remote_subview, deep_copy) {
+  test_subview_deep_copy<int, KOKKOS_TEST_REMOTE_MEMORY_SPACE>(32, 16);
+  test_subview_deep_copy<double, KOKKOS_TEST_REMOTE_MEMORY_SPACE>(256, 64);
+}
+
+TEST(remote_subview, ranks) {
+  test_subview_ranks<int, KOKKOS_TEST_REMOTE_MEMORY_SPACE>(64);
+}
+
+#endif /* TEST_SUBVIEW_HPP_ */
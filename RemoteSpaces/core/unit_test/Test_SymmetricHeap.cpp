@@ -0,0 +1,109 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  H. Carter Edwards (hcedwar@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef TEST_SYMMETRIC_HEAP_HPP_
+#define TEST_SYMMETRIC_HEAP_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+
+template <class DataType>
+void test_symmetric_heap(const int N, const int steps) {
+  int myRank, numRanks;
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+  MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+  const int target = (myRank + 1) % numRanks;
+  const int source = (myRank + numRanks - 1) % numRanks;
+  const size_t windows = Kokkos::MPISpace::window_registry.size();
+
+  typedef Kokkos::View<DataType**, Kokkos::MPISpace> remote_view_type;
+  remote_view_type persistent =
+      Kokkos::allocate_symmetric_remote_view<remote_view_type>(
+          "Persistent", numRanks, NULL, N);
+
+  // Views allocated and freed every step are carved out of the heap window
+  for (int step = 0; step < steps; step++) {
+    remote_view_type v =
+        Kokkos::allocate_symmetric_remote_view<remote_view_type>(
+            "MyView", numRanks, NULL, N + step);
+    ASSERT_EQ(Kokkos::MPISpace::window_registry.size(), windows);
+    DataType* local = v.data();
+    for (int i = 0; i < N + step; i++) local[i] = DataType(0);
+    Kokkos::MPISpace().fence();
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    for (int i = 0; i < N + step; i++)
+      v(target, i) = DataType(myRank * N + i + step);
+    Kokkos::MPISpace().fence();
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    for (int i = 0; i < N + step; i++)
+      ASSERT_EQ(local[i], DataType(source * N + i + step));
+    Kokkos::MPISpace().fence();
+  }
+  ASSERT_EQ(Kokkos::MPISpace::symmetric_heap.live_allocations(), size_t(1));
+
+  // Allocations that do not fit get their own window
+  remote_view_type large =
+      Kokkos::allocate_symmetric_remote_view<remote_view_type>(
+          "Large", numRanks, NULL,
+          Kokkos::MPISpace::symmetric_heap.size() / sizeof(DataType));
+  ASSERT_EQ(Kokkos::MPISpace::window_registry.size(), windows + 1);
+  large(target, 0) = DataType(myRank);
+  Kokkos::MPISpace().fence();
+  MPI_Barrier(MPI_COMM_WORLD);
+  ASSERT_EQ(large.data()[0], DataType(source));
+  Kokkos::MPISpace().fence();
+}
+
+TEST(symmetric_heap, allocate_free) {
+  Kokkos::MPISpace::set_symmetric_heap(1 << 20);
+  test_symmetric_heap<int>(100, 10);
+  test_symmetric_heap<double>(100, 10);
+  Kokkos::MPISpace::set_symmetric_heap(0);
+  ASSERT_FALSE(Kokkos::MPISpace::symmetric_heap.active());
+}
+
+#endif /* TEST_SYMMETRIC_HEAP_HPP_ */
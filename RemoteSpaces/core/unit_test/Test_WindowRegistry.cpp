@@ -0,0 +1,112 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  H. Carter Edwards (hcedwar@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef TEST_WINDOW_REGISTRY_HPP_
+#define TEST_WINDOW_REGISTRY_HPP_
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_RemoteSpaces.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Concurrent registration and removal of windows from several host threads.
+// Allocation pointers are stand-ins since window creation is collective and
+// cannot be issued concurrently on the same communicator.
+void test_window_registry_stress(const int num_threads, const int num_views,
+                                 const int repeat) {
+  Kokkos::Impl::MPIWindowRegistry registry;
+  std::vector<char> storage(num_threads * num_views);
+  std::atomic<int> errors(0);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t]() {
+      char* ptrs = storage.data() + t * num_views;
+      Kokkos::Impl::MPIWindows windows = {MPI_WIN_NULL, MPI_WIN_NULL,
+                                          MPI_COMM_WORLD};
+      for (int r = 0; r < repeat; r++) {
+        for (int i = 0; i < num_views; i++) registry.insert(ptrs + i, windows);
+        for (int i = 0; i < num_views; i++)
+          if (!registry.find(ptrs + i, windows)) errors++;
+        for (int i = num_views - 1; i >= 0; i--)
+          if (!registry.erase(ptrs + i, windows)) errors++;
+        if (registry.find(ptrs, windows)) errors++;
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  ASSERT_EQ(errors.load(), 0);
+  ASSERT_EQ(registry.size(), size_t(0));
+}
+
+TEST(window_registry, concurrent_allocations) {
+  test_window_registry_stress(8, 1000, 10);
+}
+
+TEST(window_registry, allocate_free) {
+  int numRanks;
+  MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+  const size_t live = Kokkos::MPISpace::window_registry.size();
+
+  typedef Kokkos::View<double**, Kokkos::MPISpace> remote_view_type;
+  {
+    std::vector<remote_view_type> views;
+    for (int i = 0; i < 64; i++)
+      views.push_back(
+          Kokkos::allocate_symmetric_remote_view<remote_view_type>(
+              "MyView", numRanks, NULL, 8));
+    ASSERT_EQ(Kokkos::MPISpace::window_registry.size(), live + 64);
+    // Free out of allocation order
+    for (int i = 0; i < 64; i += 2) views[i] = remote_view_type();
+    Kokkos::MPISpace().fence();
+    ASSERT_EQ(Kokkos::MPISpace::window_registry.size(), live + 32);
+  }
+  ASSERT_EQ(Kokkos::MPISpace::window_registry.size(), live);
+}
+
+#endif /* TEST_WINDOW_REGISTRY_HPP_ */